@@ -1,6 +1,8 @@
 #!/bin/bash
 # Sweep over percentage of tasks which have GPU segments
 NUM_TASKSETS=5000
+CI_WIDTH=0	# stop a point once every test's 95% interval is narrower than this (0 = always NUM_TASKSETS)
+CRN_SEED=1	# taskset i of every point shares its random draws (common random numbers, 0 = fresh draws per point)
 HARMONIC_FLAG=0
 FILENAME=$1	#mcproc_gpu_percent_sweep_.csv
 EPSILON=0.01
@@ -11,10 +13,17 @@ MAX_NUM_TASKS=10
 MAX_GPU_FRACTION=$2 #0.3 0.5 0.7 1.0
 MODE=1
 NUM_CORES=4
+STATE=$FILENAME.$2.state	# points completed so far (per GPU fraction, the sweeps may share a file)
+CHECKPOINT=$FILENAME.$2.ckpt	# progress of the point being run
+touch $STATE
 for gpu_percent in {0..70..10}
 do
 	GPU_TASK_FRACTION=$(echo "scale = 1; $gpu_percent/100" | bc)
 	echo $GPU_TASK_FRACTION
-	../src/mcprocessor_exp.out $NUM_TASKSETS $HARMONIC_FLAG $FILENAME $EPSILON $CPU_UTIL $GPU_UTIL $GPU_TASK_FRACTION $MAX_GPU_SEGMENTS $MAX_NUM_TASKS $MAX_GPU_FRACTION $MODE $NUM_CORES
+	# Skip the points a killed sweep completed, resume the one it stopped in
+	grep -qx "$GPU_TASK_FRACTION" $STATE && continue
+	RESUME=""
+	[ -f $CHECKPOINT ] && RESUME="--resume"
+	../src/mcprocessor_exp.out $NUM_TASKSETS $HARMONIC_FLAG $FILENAME $EPSILON $CPU_UTIL $GPU_UTIL $GPU_TASK_FRACTION $MAX_GPU_SEGMENTS $MAX_NUM_TASKS $MAX_GPU_FRACTION $MODE $NUM_CORES --ci-width $CI_WIDTH --crn-seed $CRN_SEED --checkpoint $CHECKPOINT $RESUME && echo $GPU_TASK_FRACTION >> $STATE
 done
 exit 0
\ No newline at end of file
@@ -1,6 +1,8 @@
 #!/bin/bash
 # Sweep over the task with the largest fractional requirement of the GPU
 NUM_TASKSETS=5000
+CI_WIDTH=0	# stop a point once every test's 95% interval is narrower than this (0 = always NUM_TASKSETS)
+CRN_SEED=1	# taskset i of every point shares its random draws (common random numbers, 0 = fresh draws per point)
 HARMONIC_FLAG=0
 FILENAME=$1	#mcproc_gpu_fraction_sweep.csv
 EPSILON=0.01
@@ -11,10 +13,17 @@ MAX_GPU_SEGMENTS=10
 MAX_NUM_TASKS=10
 MODE=3
 NUM_CORES=4
+STATE=$FILENAME.state		# points completed so far
+CHECKPOINT=$FILENAME.ckpt	# progress of the point being run
+touch $STATE
 for max_gpu_fraction in {10..100..10}
 do
 	MAX_GPU_FRACTION=$(echo "scale = 1; $max_gpu_fraction/100" | bc)
 	echo $MAX_GPU_FRACTION
-	../src/mcprocessor_exp.out $NUM_TASKSETS $HARMONIC_FLAG $FILENAME $EPSILON $CPU_UTIL $GPU_UTIL $GPU_TASK_FRACTION $MAX_GPU_SEGMENTS $MAX_NUM_TASKS $MAX_GPU_FRACTION $MODE $NUM_CORES
+	# Skip the points a killed sweep completed, resume the one it stopped in
+	grep -qx "$MAX_GPU_FRACTION" $STATE && continue
+	RESUME=""
+	[ -f $CHECKPOINT ] && RESUME="--resume"
+	../src/mcprocessor_exp.out $NUM_TASKSETS $HARMONIC_FLAG $FILENAME $EPSILON $CPU_UTIL $GPU_UTIL $GPU_TASK_FRACTION $MAX_GPU_SEGMENTS $MAX_NUM_TASKS $MAX_GPU_FRACTION $MODE $NUM_CORES --ci-width $CI_WIDTH --crn-seed $CRN_SEED --checkpoint $CHECKPOINT $RESUME && echo $MAX_GPU_FRACTION >> $STATE
 done
 exit 0
\ No newline at end of file
@@ -0,0 +1,31 @@
+#!/bin/bash
+# Sweep over CPU utilization, reporting the minimum number of cores needed per taskset and test
+NUM_TASKSETS=5000
+CI_WIDTH=0	# stop a point once every test's 95% interval is narrower than this (0 = always NUM_TASKSETS)
+CRN_SEED=1	# taskset i of every point shares its random draws (common random numbers, 0 = fresh draws per point)
+HARMONIC_FLAG=0
+FILENAME=$1 #mcproc_min_cores_sweep_.csv
+EPSILON=0.01
+GPU_UTIL=0.3
+GPU_TASK_FRACTION=0.5
+MAX_GPU_SEGMENTS=10
+MAX_NUM_TASKS=15
+MAX_GPU_FRACTION=$2 #0.3 0.5 0.7 1.0
+MODE=0
+MAX_NUM_CORES=16
+LOCAL_SEARCH_RESTARTS=0
+MIN_CORE_FLAG=1
+STATE=$FILENAME.$2.state	# points completed so far (per GPU fraction, the sweeps may share a file)
+CHECKPOINT=$FILENAME.$2.ckpt	# progress of the point being run
+touch $STATE
+for cpu_util in {40..600..40}
+do
+	CPU_UTIL=$(echo "scale = 1; $cpu_util/100" | bc)
+	echo $CPU_UTIL
+	# Skip the points a killed sweep completed, resume the one it stopped in
+	grep -qx "$CPU_UTIL" $STATE && continue
+	RESUME=""
+	[ -f $CHECKPOINT ] && RESUME="--resume"
+	../src/mcprocessor_exp.out $NUM_TASKSETS $HARMONIC_FLAG $FILENAME $EPSILON $CPU_UTIL $GPU_UTIL $GPU_TASK_FRACTION $MAX_GPU_SEGMENTS $MAX_NUM_TASKS $MAX_GPU_FRACTION $MODE $MAX_NUM_CORES $LOCAL_SEARCH_RESTARTS $MIN_CORE_FLAG --ci-width $CI_WIDTH --crn-seed $CRN_SEED --checkpoint $CHECKPOINT $RESUME && echo $CPU_UTIL >> $STATE
+done
+exit 0
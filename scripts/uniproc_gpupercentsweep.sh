@@ -1,6 +1,7 @@
 #!/bin/bash
 # Sweep over percentage of tasks which have GPU segments
 NUM_TASKSETS=5000
+CRN_SEED=1	# taskset i of every point shares its random draws (common random numbers, 0 = fresh draws per point)
 HARMONIC_FLAG=0
 FILENAME=$1	#gpu_percent_sweep_.csv
 EPSILON=0.01
@@ -14,6 +15,6 @@ for gpu_percent in {0..70..10}
 do
 	GPU_TASK_FRACTION=$(echo "scale = 1; $gpu_percent/100" | bc)
 	echo $GPU_TASK_FRACTION
-	../src/uniprocessor_exp.out $NUM_TASKSETS $HARMONIC_FLAG $FILENAME $EPSILON $CPU_UTIL $GPU_UTIL $GPU_TASK_FRACTION $MAX_GPU_SEGMENTS $MAX_NUM_TASKS $MAX_GPU_FRACTION $MODE
+	../src/uniprocessor_exp.out $NUM_TASKSETS $HARMONIC_FLAG $FILENAME $EPSILON $CPU_UTIL $GPU_UTIL $GPU_TASK_FRACTION $MAX_GPU_SEGMENTS $MAX_NUM_TASKS $MAX_GPU_FRACTION $MODE --crn-seed $CRN_SEED
 done
 exit 0
\ No newline at end of file
@@ -0,0 +1,294 @@
+/*
+ * @file admission_exp.cpp
+ * @brief Batch admission analysis of imported tasksets
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard Library Imports */
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+/* Internal Headers */
+#include "task.hpp"
+#include "taskset.hpp"
+#include "taskset-loader.hpp"
+#include "task_partitioning.hpp"
+#include "bounded-queue.hpp"
+#include "sched-config.hpp"
+#include "config.hpp"
+
+// Comparator class for ordering tasks using RMS
+struct CompareTaskPriorityRMS {
+    bool operator()(Task const & t1, Task const & t2) {
+        // return "true" if "t1" has higher RMS priority than "t2"
+        return t1.getT() < t2.getT();
+    }
+} ComparePriorityRMS;
+
+// Order of the schedulability tests in the output file
+const sched_type csv_order[INVALID] = {REQUEST_DRIVEN, JOB_DRIVEN, HYBRID, REQUEST_DRIVEN_CONC, JOB_DRIVEN_CONC, 
+									   REQUEST_DRIVEN_CONC_SIMPLE, JOB_DRIVEN_CONC_RO, HYBRID_CONC, FIFO_CONC};
+
+// Imported taskset awaiting analysis (an empty taskset tells a worker to stop)
+typedef struct admission_request {
+	long index;
+	std::string name;
+	std::vector<Task> task_vector;
+} admission_request_t;
+
+// Admission verdicts of one taskset
+typedef struct admission_result {
+	long index;
+	std::string name;
+	int num_tasks;
+	int wfd_flag[INVALID];			// 0 if admitted under WFD
+	int sa_flag[INVALID];			// 0 if admitted under SA-WFD
+	double cpu_util;
+	double gpu_util;
+} admission_result_t;
+
+/**************** Analyse an imported taskset with every test, under WFD and SA-WFD ********************/ 
+void admit_taskset(admission_request_t &request, int num_cores, admission_result_t &result)
+{
+	std::vector<Task> &task_vector = request.task_vector;
+
+	// Request-Driven Vectors
+	std::vector<double> resp_time_rd;
+	std::vector<std::vector<double>> req_blocking_rd;
+
+	// Job-Driven Vectors
+	std::vector<double> resp_time_jd;
+	std::vector<double> job_blocking_jd;
+
+	result.index = request.index;
+	result.name = request.name;
+	result.num_tasks = task_vector.size();
+
+	// Sort Vector based on Some Priority ordering (here RMS)
+	std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+
+	for (int test = 0; test < INVALID; test++)
+	{
+		resp_time_rd.clear();
+		req_blocking_rd.clear();
+		resp_time_jd.clear();
+		job_blocking_jd.clear();
+		result.wfd_flag[test] = worst_fit_decreasing(task_vector, num_cores, (sched_type) test, resp_time_rd, resp_time_jd, 
+													 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
+
+		resp_time_rd.clear();
+		req_blocking_rd.clear();
+		resp_time_jd.clear();
+		job_blocking_jd.clear();
+		result.sa_flag[test] = sync_aware_worst_fit_decreasing(task_vector, num_cores, (sched_type) test, resp_time_rd, resp_time_jd, 
+															   req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
+	}
+
+	result.cpu_util = get_taskset_cpu_util(task_vector);
+	result.gpu_util = get_taskset_gpu_util(task_vector);
+}
+
+int main(int argc, char **argv)
+{
+	TasksetLoader loader;
+	std::ofstream outfile;
+	int file_flag = 0;
+
+	// Runtime configuration (--config <key>=<value>, --config-file <file>), the positional arguments follow without it
+	std::vector<char *> positional_args;
+	for (int index = 0; index < argc; index++)
+	{
+		std::string arg(argv[index]);
+		if (arg == "--config" && index + 1 < argc)
+		{
+			if (apply_sched_config(argv[++index]) != 0)
+				exit(1);
+		}
+		else if (arg == "--config-file" && index + 1 < argc)
+		{
+			if (apply_sched_config_file(argv[++index]) != 0)
+				exit(1);
+		}
+		else
+			positional_args.push_back(argv[index]);
+	}
+	argc = positional_args.size();
+	argv = positional_args.data();
+
+	if (argc < 2)
+	{
+		std::cout << "Usage: " << argv[0] << " <taskset file> [output file] [number of cores] [number of workers]"
+				  << " [--config <key>=<value>] [--config-file <file>]\n";
+		exit(1);
+	}
+
+	// Taskset description
+	if (loader.open(argv[1]) != 0)
+		exit(1);
+
+	// Output filename (one line of verdicts per taskset, in file order)
+	if (argc > 2 && std::string(argv[2]) != "-")
+	{
+		file_flag = 1;
+		outfile.open(argv[2], std::ios_base::trunc);
+	}
+
+	// Number of Cores
+	int num_cores = 4;
+	if (argc > 3)
+		num_cores = std::atoi(argv[3]);
+
+	// Number of analysis workers (0 = one per hardware thread)
+	int num_workers = 0;
+	if (argc > 4)
+		num_workers = std::atoi(argv[4]);
+	if (num_workers <= 0)
+		num_workers = std::max(1u, std::thread::hardware_concurrency());
+
+	BoundedQueue<admission_request_t> request_queue(PIPELINE_QUEUE_DEPTH);
+	BoundedQueue<admission_result_t> result_queue(PIPELINE_QUEUE_DEPTH);
+	std::atomic<long> num_requests(-1);		// known once the whole file has been read
+	std::atomic<int> load_error(0);
+	std::vector<std::thread> threads;
+	int wfd_counter[INVALID] = {0};
+	int sa_counter[INVALID] = {0};
+
+	auto start = std::chrono::steady_clock::now();
+
+	// Analysis workers
+	for (int w = 0; w < num_workers; w++)
+	{
+		threads.emplace_back([&]()
+		{
+			admission_request_t request;
+			admission_result_t result;
+			while (true)
+			{
+				while (!request_queue.tryPop(request))
+					std::this_thread::yield();
+				if (request.task_vector.empty())
+					break;
+
+				admit_taskset(request, num_cores, result);
+				while (!result_queue.tryPush(result))
+					std::this_thread::yield();
+			}
+		});
+	}
+
+	// Writer -> restores the file order, workers finish out of order
+	threads.emplace_back([&]()
+	{
+		std::map<long, admission_result_t> reorder;
+		admission_result_t result;
+		long written = 0;
+		while (num_requests.load() < 0 || written < num_requests.load())
+		{
+			if (!result_queue.tryPop(result))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+			reorder[result.index] = result;
+
+			while (!reorder.empty() && reorder.begin()->first == written)
+			{
+				const admission_result_t &next = reorder.begin()->second;
+				for (int test = 0; test < INVALID; test++)
+				{
+					if (next.wfd_flag[test] == 0)
+						wfd_counter[test]++;
+					if (next.sa_flag[test] == 0)
+						sa_counter[test]++;
+				}
+				if (file_flag == 1)
+				{
+					outfile << next.name << "," << next.num_tasks << "," << next.cpu_util << "," << next.gpu_util;
+					for (int test = 0; test < INVALID; test++)
+						outfile << "," << (next.wfd_flag[csv_order[test]] == 0);
+					for (int test = 0; test < INVALID; test++)
+						outfile << "," << (next.sa_flag[csv_order[test]] == 0);
+					outfile << "\n";
+				}
+				reorder.erase(reorder.begin());
+				written++;
+			}
+		}
+	});
+
+	// Reader -> this thread, streaming the file into the ring
+	admission_request_t request;
+	long index = 0;
+	int retval;
+	while ((retval = loader.next(request.task_vector, request.name)) == 1)
+	{
+		request.index = index++;
+		while (!request_queue.tryPush(request))
+			std::this_thread::yield();
+	}
+	if (retval < 0)
+		load_error = 1;
+	num_requests = index;
+
+	// Stop the workers
+	for (int w = 0; w < num_workers; w++)
+	{
+		request.task_vector.clear();
+		while (!request_queue.tryPush(request))
+			std::this_thread::yield();
+	}
+
+	for (unsigned int t = 0; t < threads.size(); t++)
+		threads[t].join();
+
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (file_flag == 1)
+		outfile.close();
+
+	std::cout << "Tasksets: " << index << "\n";
+	std::cout << "Workers: " << num_workers << "\n";
+	std::cout << "Throughput (tasksets/s): " << index/elapsed << "\n";
+
+	std::cout << "WFD Admitted " << "\n";
+	for (int test = 0; test < INVALID; test++)
+		std::cout << get_sched_type_label(test) << ": " << wfd_counter[test] << "\n";
+
+	std::cout << "SA-WFD Admitted " << "\n";
+	for (int test = 0; test < INVALID; test++)
+		std::cout << get_sched_type_label(test) << ": " << sa_counter[test] << "\n";
+
+	// The tasksets before the malformed line were analysed
+	if (load_error)
+		return 1;
+	return 0;
+}
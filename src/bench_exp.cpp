@@ -0,0 +1,724 @@
+/*
+ * @file bench_exp.cpp
+ * @brief Microbenchmarks of the analysis kernels on fixed taskset corpora
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Standard Library Imports */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cmath>
+#include <new>
+#include <chrono>
+
+/* Internal Headers */
+#include "task.hpp"
+#include "taskset-gen.hpp"
+#include "task_partitioning.hpp"
+#include "sched-cache.hpp"
+#include "sched-config.hpp"
+#include "indirect-cis.hpp"
+#include "request-driven-test.hpp"
+#include "job-driven-test.hpp"
+#include "hybrid-test.hpp"
+#include "request-driven-test-conc.hpp"
+#include "job-driven-test-conc.hpp"
+#include "hybrid-test-conc.hpp"
+#include "fifo-test-conc.hpp"
+#include "config.hpp"
+
+// Comparator class for ordering tasks using RMS
+struct CompareTaskPriorityRMS {
+    bool operator()(Task const & t1, Task const & t2) {
+        // return "true" if "t1" has higher RMS priority than "t2"
+        return t1.getT() < t2.getT();
+    }
+} ComparePriorityRMS;
+
+/* Allocation counters (operator new is replaced below, the counts cover the timed passes only); the live heap bytes are
+   tracked throughout, each block keeps its size in a header */
+static bool count_allocations = false;
+static long num_allocations = 0;
+static long allocated_bytes = 0;
+static long live_bytes = 0;
+static long peak_live_bytes = 0;
+
+#define ALLOC_HEADER_SIZE 16
+
+void *operator new(std::size_t size)
+{
+	if (count_allocations)
+	{
+		num_allocations++;
+		allocated_bytes += size;
+	}
+	char *block = (char *) std::malloc(size + ALLOC_HEADER_SIZE);
+	if (block == NULL)
+		throw std::bad_alloc();
+	*(std::size_t *) block = size;
+	live_bytes += size;
+	peak_live_bytes = std::max(peak_live_bytes, live_bytes);
+	return block + ALLOC_HEADER_SIZE;
+}
+
+void operator delete(void *ptr) noexcept
+{
+	if (ptr == NULL)
+		return;
+	char *block = (char *) ptr - ALLOC_HEADER_SIZE;
+	live_bytes -= *(std::size_t *) block;
+	std::free(block);
+}
+
+/* Fixed corpus of partitioned tasksets */
+typedef struct bench_corpus {
+	const char *name;
+	int num_tasks;
+	int num_cores;
+	double utilization;				// total CPU utilization, about half of each core
+	std::vector<std::vector<Task>> tasksets;	// in RMS order, mapped to the cores by utilization (worst fit)
+} bench_corpus_t;
+
+/* Timing of one kernel on one corpus */
+typedef struct bench_result {
+	std::string kernel;
+	std::string corpus;
+	long ops;						// kernel calls per pass over the corpus
+	double ns_per_op;				// median over the timed passes
+	double min_ns_per_op;
+	double allocs_per_op;
+	double bytes_per_op;
+	double checksum;				// sum of the kernel outputs, changes if an optimization changes the results
+} bench_result_t;
+
+/**************** Map a taskset to the cores by utilization (worst fit, without a schedulability test) ********************/ 
+static void map_worst_fit(std::vector<Task> &task_vector, int num_cores)
+{
+	std::vector<double> core_util(num_cores, 0);
+	std::vector<unsigned int> order(task_vector.size());
+
+	for (unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b)
+	{
+		return task_vector[a].getE()/task_vector[a].getT() > task_vector[b].getE()/task_vector[b].getT();
+	});
+	for (unsigned int i = 0; i < order.size(); i++)
+	{
+		unsigned int core = std::min_element(core_util.begin(), core_util.end()) - core_util.begin();
+		task_vector[order[i]].setCoreID(core);
+		core_util[core] += task_vector[order[i]].getE()/task_vector[order[i]].getT();
+	}
+	std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+}
+
+/**************** Build a benchmark corpus ********************/ 
+/* The tasksets come from fixed generator streams, so every build benchmarks the same inputs */
+static void build_corpus(bench_corpus_t &corpus, unsigned int corpus_index)
+{
+	std::vector<Task> task_vector;
+
+	corpus.tasksets.clear();
+	for (unsigned int index = 0; corpus.tasksets.size() < BENCH_CORPUS_TASKSETS; index++)
+	{
+		seed_taskset_stream(BENCH_SEED + corpus_index, index);
+		task_vector = generate_tasks(corpus.num_tasks, ceil(FRACTION_TASKS_GPU*corpus.num_tasks), MAX_GPU_SEGMENTS, corpus.utilization,
+									 0.3, 0, 1, MAX_GPU_FRACTION);
+		if (task_vector.empty())
+			continue;
+		map_worst_fit(task_vector, corpus.num_cores);
+		corpus.tasksets.push_back(task_vector);
+	}
+}
+
+/**************** Time a kernel ********************/ 
+/* Params: prepare: untimed reset of the inputs before each pass (may be empty)
+		   pass   : one pass over the corpus, returns the checksum of the outputs
+		   ops    : kernel calls per pass
+		   result : timings (populated by the function) */
+static void run_benchmark(const std::function<void()> &prepare, const std::function<double()> &pass, long ops, bench_result_t &result)
+{
+	std::vector<double> pass_ns;
+
+	for (int run = 0; run < BENCH_WARMUP_RUNS; run++)
+	{
+		if (prepare)
+			prepare();
+		pass();
+	}
+
+	num_allocations = 0;
+	allocated_bytes = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		if (prepare)
+			prepare();
+		count_allocations = true;
+		auto start = std::chrono::steady_clock::now();
+		result.checksum = pass();
+		auto end = std::chrono::steady_clock::now();
+		count_allocations = false;
+		pass_ns.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+	}
+
+	std::sort(pass_ns.begin(), pass_ns.end());
+	result.ops = ops;
+	result.ns_per_op = pass_ns[pass_ns.size()/2]/ops;
+	result.min_ns_per_op = pass_ns[0]/ops;
+	result.allocs_per_op = double(num_allocations)/(double(BENCH_RUNS)*ops);
+	result.bytes_per_op = double(allocated_bytes)/(double(BENCH_RUNS)*ops);
+}
+
+/**************** Sum of a vector, for the checksums ********************/ 
+static double sum_of(const std::vector<double> &values)
+{
+	double sum = 0;
+	for (unsigned int i = 0; i < values.size(); i++)
+		sum += values[i];
+	return sum;
+}
+
+/**************** Benchmark the kernels on a corpus ********************/ 
+static void bench_corpus(bench_corpus_t &corpus, std::vector<bench_result_t> &results)
+{
+	std::vector<std::vector<Task>> &tasksets = corpus.tasksets;
+	unsigned int num_tasksets = tasksets.size();
+	bench_result_t result;
+	result.corpus = corpus.name;
+
+	// Inputs of the kernels, computed by the tests themselves
+	std::vector<std::vector<double>> deadlines(num_tasksets);
+	std::vector<std::vector<double>> resp_time_rd(num_tasksets), resp_time_jd(num_tasksets);
+	std::vector<std::vector<double>> resp_time_rdc(num_tasksets), resp_time_jdc(num_tasksets), job_blocking_jdc(num_tasksets);
+	std::vector<std::vector<std::vector<double>>> req_blocking_rd(num_tasksets), req_blocking_rdc(num_tasksets);
+	std::vector<double> scratch;
+	std::vector<std::vector<double>> req_scratch;
+	long num_tasks = 0, num_requests = 0;
+	for (unsigned int k = 0; k < num_tasksets; k++)
+	{
+		pre_compute_gpu_response_time(tasksets[k]);
+		for (unsigned int i = 0; i < tasksets[k].size(); i++)
+		{
+			deadlines[k].push_back(tasksets[k][i].getD());
+			num_requests += tasksets[k][i].getNumGPUSegments();
+		}
+		num_tasks += tasksets[k].size();
+		check_schedulability_request_driven(tasksets[k], resp_time_rd[k], req_blocking_rd[k]);
+		check_schedulability_job_driven(tasksets[k], resp_time_jd[k]);
+		check_schedulability_request_driven_conc(tasksets[k], resp_time_rdc[k], req_blocking_rdc[k], false);
+		check_schedulability_job_driven_conc(tasksets[k], resp_time_jdc[k], job_blocking_jdc[k], true);
+	}
+
+	// GPU segment response times
+	result.kernel = "pre_compute_gpu_response_time";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+		{
+			pre_compute_gpu_response_time(tasksets[k]);
+			for (unsigned int i = 0; i < tasksets[k].size(); i++)
+				checksum += tasksets[k][i].getTotalH();
+		}
+		return checksum;
+	}, num_tasksets, result);
+	results.push_back(result);
+
+	// Liquefaction masses (one call per request, or per task for the job-driven mass), over the deadlines of the other tasks
+	result.kernel = "calculate_liquefaction_mass_rdc";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+			for (unsigned int i = 0; i < tasksets[k].size(); i++)
+				for (unsigned int j = 0; j < tasksets[k][i].getNumGPUSegments(); j++)
+					checksum += calculate_liquefaction_mass_rdc(i, j, deadlines[k][i], tasksets[k], deadlines[k]);
+		return checksum;
+	}, num_requests, result);
+	results.push_back(result);
+
+	result.kernel = "calculate_liquefaction_mass_jdc";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+			for (unsigned int i = 0; i < tasksets[k].size(); i++)
+				checksum += calculate_liquefaction_mass_jdc(i, deadlines[k][i], tasksets[k], deadlines[k]);
+		return checksum;
+	}, num_tasks, result);
+	results.push_back(result);
+
+	result.kernel = "calculate_liquefaction_mass_rojdc";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+			for (unsigned int i = 0; i < tasksets[k].size(); i++)
+				for (unsigned int j = 0; j < tasksets[k][i].getNumGPUSegments(); j++)
+					checksum += calculate_liquefaction_mass_rojdc(i, j, deadlines[k][i], tasksets[k], deadlines[k]);
+		return checksum;
+	}, num_requests, result);
+	results.push_back(result);
+
+	// Response times of all the tasks of a taskset (one call per taskset); the concurrent kernels read the mode of the test
+	// last run on the thread, so each is set by running its test first
+	result.kernel = "calculate_hp_resp_time_rd";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+		{
+			req_scratch.clear();
+			checksum += sum_of(calculate_hp_resp_time_rd(tasksets[k].size(), tasksets[k], req_scratch));
+		}
+		return checksum;
+	}, num_tasksets, result);
+	results.push_back(result);
+
+	result.kernel = "calculate_hp_resp_time_jd";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+			checksum += sum_of(calculate_hp_resp_time_jd(tasksets[k].size(), tasksets[k]));
+		return checksum;
+	}, num_tasksets, result);
+	results.push_back(result);
+
+	result.kernel = "calculate_hp_resp_time_hybrid";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+			checksum += sum_of(calculate_hp_resp_time_hybrid(tasksets[k].size(), tasksets[k], resp_time_rd[k], resp_time_jd[k], 
+															 req_blocking_rd[k]));
+		return checksum;
+	}, num_tasksets, result);
+	results.push_back(result);
+
+	for (int simple = 1; simple >= 0; simple--)
+	{
+		std::vector<double> resp_time;
+		check_schedulability_request_driven_conc(tasksets[0], resp_time, req_scratch, simple == 1);
+		result.kernel = simple ? "calculate_hp_resp_time_rdc_simple" : "calculate_hp_resp_time_rdc";
+		run_benchmark(nullptr, [&]()
+		{
+			double checksum = 0;
+			for (unsigned int k = 0; k < num_tasksets; k++)
+			{
+				req_scratch.clear();
+				checksum += sum_of(calculate_hp_resp_time_rdc(tasksets[k].size(), tasksets[k], req_scratch));
+			}
+			return checksum;
+		}, num_tasksets, result);
+		results.push_back(result);
+	}
+
+	for (int ro = 0; ro <= 1; ro++)
+	{
+		std::vector<double> resp_time;
+		check_schedulability_job_driven_conc(tasksets[0], resp_time, scratch, ro == 1);
+		result.kernel = ro ? "calculate_hp_resp_time_jdc_ro" : "calculate_hp_resp_time_jdc";
+		run_benchmark(nullptr, [&]()
+		{
+			double checksum = 0;
+			for (unsigned int k = 0; k < num_tasksets; k++)
+			{
+				scratch.assign(tasksets[k].size(), 0);
+				checksum += sum_of(calculate_hp_resp_time_jdc(tasksets[k].size(), tasksets[k], scratch));
+			}
+			return checksum;
+		}, num_tasksets, result);
+		results.push_back(result);
+	}
+
+	result.kernel = "calculate_hp_resp_time_hybrid_conc";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+			checksum += sum_of(calculate_hp_resp_time_hybrid_conc(tasksets[k].size(), tasksets[k], resp_time_rdc[k], resp_time_jdc[k],
+																  req_blocking_rdc[k], job_blocking_jdc[k]));
+		return checksum;
+	}, num_tasksets, result);
+	results.push_back(result);
+
+	result.kernel = "calculate_hp_resp_time_fifo";
+	run_benchmark(nullptr, [&]()
+	{
+		double checksum = 0;
+		for (unsigned int k = 0; k < num_tasksets; k++)
+			checksum += sum_of(calculate_hp_resp_time_fifo(tasksets[k].size(), tasksets[k]));
+		return checksum;
+	}, num_tasksets, result);
+	results.push_back(result);
+
+	// WFD from an unmapped copy of each taskset (one call per taskset), with the verdict cache off so every probe is analysed
+	std::vector<std::vector<Task>> unmapped(num_tasksets);
+	std::vector<double> rd, jd, jb;
+	std::vector<std::vector<double>> rb;
+	for (int test = 0; test < INVALID; test++)
+	{
+		result.kernel = std::string("worst_fit_decreasing_") + sched_type_keys[test];
+		run_benchmark([&]()
+		{
+			for (unsigned int k = 0; k < num_tasksets; k++)
+				unmapped[k] = tasksets[k];
+		}, [&]()
+		{
+			double checksum = 0;
+			for (unsigned int k = 0; k < num_tasksets; k++)
+			{
+				rd.clear();
+				jd.clear();
+				rb.clear();
+				jb.clear();
+				checksum += (worst_fit_decreasing(unmapped[k], corpus.num_cores, (sched_type) test, rd, jd, rb, jb, ComparePriorityRMS) == 0);
+				for (unsigned int i = 0; i < unmapped[k].size(); i++)
+					checksum += unmapped[k][i].getCoreID()*(i + 1)*1e-3;
+			}
+			return checksum;
+		}, num_tasksets, result);
+		results.push_back(result);
+	}
+}
+
+/**************** Read the results of an earlier run ********************/ 
+/* Returns: 0 on success, -1 if the file cannot be read */
+static int read_baseline(const std::string &filename, std::map<std::string, bench_result_t> &baseline)
+{
+	std::ifstream infile(filename);
+	std::string line;
+
+	if (!infile)
+	{
+		std::cerr << "Bench: cannot read " << filename << "\n";
+		return -1;
+	}
+	while (std::getline(infile, line))
+	{
+		if (line.empty() || line[0] == '#' || line.compare(0, 7, "kernel,") == 0)
+			continue;
+		std::replace(line.begin(), line.end(), ',', ' ');
+		std::istringstream fields(line);
+		bench_result_t result;
+		if (fields >> result.kernel >> result.corpus >> result.ops >> result.ns_per_op >> result.min_ns_per_op 
+				   >> result.allocs_per_op >> result.bytes_per_op >> result.checksum)
+			baseline[result.kernel + "/" + result.corpus] = result;
+	}
+	return 0;
+}
+
+/* Cost of one test at one point of the scalability sweep */
+typedef struct scaling_point {
+	char axis;						// 'n' (task count swept) or 'm' (segments per GPU task swept)
+	int test;
+	int num_tasks;
+	int num_segments;
+	double ns_per_analysis;
+	double peak_bytes;				// largest heap growth during an analysis
+	double allocs_per_analysis;
+} scaling_point_t;
+
+/**************** Build the tasksets of a scalability point ********************/ 
+/* Every point draws from the same streams (common random numbers), the GPU tasks have exactly num_segments segments; the
+   cores are half loaded, or less if the tasks cannot reach it under their utilization bound */
+static void build_scaling_tasksets(int num_tasks, int num_segments, int num_cores, std::vector<std::vector<Task>> &tasksets)
+{
+	std::vector<Task> task_vector;
+	double utilization = std::min(0.5*num_cores, 0.5*get_sched_config().cpu_task_upper_bound*num_tasks);
+
+	tasksets.clear();
+	for (unsigned int index = 0; tasksets.size() < BENCH_SCALING_TASKSETS; index++)
+	{
+		seed_taskset_stream(BENCH_SEED, index);
+		task_vector = generate_tasks(num_tasks, ceil(FRACTION_TASKS_GPU*num_tasks), num_segments, utilization, 0.3, 0, 0, 
+									 MAX_GPU_FRACTION);
+		if (task_vector.empty())
+			continue;
+		map_worst_fit(task_vector, num_cores);
+		tasksets.push_back(task_vector);
+	}
+}
+
+/**************** Measure one test on the tasksets of a scalability point ********************/ 
+/* The tasksets are analysed in turn until BENCH_SCALING_MIN_TIME seconds have been spent */
+static void measure_scaling_point(std::vector<std::vector<Task>> &tasksets, sched_type test, scaling_point_t &point)
+{
+	std::vector<double> resp_time;
+	double elapsed = 0;
+	long num_analyses = 0;
+	long peak_bytes = 0;
+
+	get_partition_response_times(tasksets[0], test, resp_time);
+	num_allocations = 0;
+	while (elapsed < BENCH_SCALING_MIN_TIME)
+	{
+		for (unsigned int k = 0; k < tasksets.size(); k++)
+		{
+			long base_bytes = live_bytes;
+			peak_live_bytes = live_bytes;
+			count_allocations = true;
+			auto start = std::chrono::steady_clock::now();
+			get_partition_response_times(tasksets[k], test, resp_time);
+			auto end = std::chrono::steady_clock::now();
+			count_allocations = false;
+			peak_bytes = std::max(peak_bytes, peak_live_bytes - base_bytes);
+			elapsed += std::chrono::duration<double>(end - start).count();
+			num_analyses++;
+		}
+	}
+
+	point.test = test;
+	point.ns_per_analysis = elapsed*1e9/num_analyses;
+	point.peak_bytes = peak_bytes;
+	point.allocs_per_analysis = double(num_allocations)/num_analyses;
+}
+
+/**************** Fit cost = a*x^b over the points of an axis ********************/ 
+/* Least squares on the logarithms
+   Returns: the exponent b (0 with fewer than two points) */
+static double fit_exponent(const std::vector<double> &x, const std::vector<double> &cost)
+{
+	double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+	unsigned int num_points = 0;
+
+	for (unsigned int i = 0; i < x.size(); i++)
+	{
+		if (x[i] <= 0 || cost[i] <= 0)
+			continue;
+		double lx = std::log(x[i]);
+		double ly = std::log(cost[i]);
+		sum_x += lx;
+		sum_y += ly;
+		sum_xx += lx*lx;
+		sum_xy += lx*ly;
+		num_points++;
+	}
+	double denominator = num_points*sum_xx - sum_x*sum_x;
+	if (num_points < 2 || denominator <= 0)
+		return 0;
+	return (num_points*sum_xy - sum_x*sum_y)/denominator;
+}
+
+/**************** Points of a scalability axis ********************/ 
+/* Doubling from first up to last, last always included */
+static std::vector<int> axis_values(int first, int last)
+{
+	std::vector<int> values;
+	for (int value = first; value < last; value *= 2)
+		values.push_back(value);
+	values.push_back(last);
+	return values;
+}
+
+/**************** Scalability sweep of every test ********************/ 
+/* The task count is swept at MAX_GPU_SEGMENTS segments per GPU task, the segment count at BENCH_SCALING_BASE_TASKS tasks
+   (at most max_tasks); the points are written as CSV and the fitted exponents of the runtime and of the peak memory are printed
+   Params: max_tasks, max_segments: last points of the axes
+		   num_cores: cores the tasksets are mapped to, the CPU utilization is half of them
+		   out      : CSV output
+   Returns: 0 */
+static int run_scaling(int max_tasks, int max_segments, int num_cores, std::ostream &out)
+{
+	std::vector<std::vector<Task>> tasksets;
+	std::vector<scaling_point_t> points;
+	scaling_point_t point;
+	int base_tasks = std::min(BENCH_SCALING_BASE_TASKS, max_tasks);
+	int base_segments = std::min(MAX_GPU_SEGMENTS, max_segments);
+
+	std::vector<int> task_counts = axis_values(5, max_tasks);
+	std::vector<int> segment_counts = axis_values(1, max_segments);
+	for (unsigned int i = 0; i < task_counts.size() + segment_counts.size(); i++)
+	{
+		point.axis = (i < task_counts.size()) ? 'n' : 'm';
+		point.num_tasks = (point.axis == 'n') ? task_counts[i] : base_tasks;
+		point.num_segments = (point.axis == 'n') ? base_segments : segment_counts[i - task_counts.size()];
+		build_scaling_tasksets(point.num_tasks, point.num_segments, num_cores, tasksets);
+		for (int test = 0; test < INVALID; test++)
+		{
+			measure_scaling_point(tasksets, (sched_type) test, point);
+			points.push_back(point);
+		}
+		std::cerr << "Scaling: n = " << point.num_tasks << ", m = " << point.num_segments << " done\n";
+	}
+
+	out << "axis,test,tasks,segments,ns_per_analysis,peak_bytes,allocs_per_analysis\n";
+	for (unsigned int index = 0; index < points.size(); index++)
+		out << points[index].axis << "," << sched_type_keys[points[index].test] << "," << points[index].num_tasks << "," 
+			<< points[index].num_segments << "," << std::fixed << std::setprecision(0) << points[index].ns_per_analysis << "," 
+			<< points[index].peak_bytes << "," << std::setprecision(1) << points[index].allocs_per_analysis << "\n";
+
+	std::cout << "Test: runtime ~ n^a m^b, peak memory ~ n^c m^d (a, b, c, d), ms per analysis at n = " << max_tasks << " and at m = " 
+			  << max_segments << "\n";
+	std::cout << std::fixed << std::setprecision(2);
+	for (int test = 0; test < INVALID; test++)
+	{
+		std::vector<double> n, n_time, n_bytes, m, m_time, m_bytes;
+		for (unsigned int index = 0; index < points.size(); index++)
+		{
+			if (points[index].test != test)
+				continue;
+			if (points[index].axis == 'n')
+			{
+				n.push_back(points[index].num_tasks);
+				n_time.push_back(points[index].ns_per_analysis);
+				n_bytes.push_back(points[index].peak_bytes);
+			}
+			else
+			{
+				m.push_back(points[index].num_segments);
+				m_time.push_back(points[index].ns_per_analysis);
+				m_bytes.push_back(points[index].peak_bytes);
+			}
+		}
+		std::cout << sched_type_keys[test] << ": " << fit_exponent(n, n_time) << ", " << fit_exponent(m, m_time) << ", " 
+				  << fit_exponent(n, n_bytes) << ", " << fit_exponent(m, m_bytes) << ", " << std::setprecision(3) 
+				  << n_time.back()*1e-6 << ", " << m_time.back()*1e-6 << std::setprecision(2) << "\n";
+	}
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	std::ofstream outfile;
+	std::map<std::string, bench_result_t> baseline;
+
+	// Results of an earlier run to compare with (--baseline <file>), scalability sweep instead of the kernels (--scaling, with
+	// --max-tasks <n>, --max-segments <m> and --cores <cores>); the positional arguments follow without them
+	std::string baseline_filename;
+	bool scaling = false;
+	int max_tasks = BENCH_SCALING_MAX_TASKS;
+	int max_segments = BENCH_SCALING_MAX_SEGMENTS;
+	int num_cores = BENCH_SCALING_CORES;
+	std::vector<char *> positional_args;
+	for (int index = 0; index < argc; index++)
+	{
+		std::string arg(argv[index]);
+		if (arg == "--baseline" && index + 1 < argc)
+			baseline_filename = argv[++index];
+		else if (arg == "--scaling")
+			scaling = true;
+		else if (arg == "--max-tasks" && index + 1 < argc)
+			max_tasks = std::atoi(argv[++index]);
+		else if (arg == "--max-segments" && index + 1 < argc)
+			max_segments = std::atoi(argv[++index]);
+		else if (arg == "--cores" && index + 1 < argc)
+			num_cores = std::atoi(argv[++index]);
+		else
+			positional_args.push_back(argv[index]);
+	}
+	argc = positional_args.size();
+	argv = positional_args.data();
+
+	if (!baseline_filename.empty() && read_baseline(baseline_filename, baseline) != 0)
+		exit(1);
+
+	// Output filename (one line per kernel and corpus, in a fixed order so two runs diff line by line)
+	std::ostream *out = &std::cout;
+	if (argc > 1 && std::string(argv[1]) != "-")
+	{
+		outfile.open(argv[1], std::ios_base::trunc);
+		if (!outfile)
+		{
+			std::cerr << "Bench: cannot write " << argv[1] << "\n";
+			exit(1);
+		}
+		out = &outfile;
+	}
+
+	// Every probe of the partitioners is analysed
+	sched_cache_set_capacity(0);
+
+	if (scaling)
+	{
+		if (max_tasks < 5 || max_segments < 1 || num_cores < 1)
+		{
+			std::cerr << "Bench: the scalability sweep needs at least 5 tasks, 1 segment and 1 core\n";
+			exit(1);
+		}
+		return run_scaling(max_tasks, max_segments, num_cores, *out);
+	}
+
+	bench_corpus_t corpora[3];
+	corpora[0].name = "small";
+	corpora[0].num_tasks = 5;
+	corpora[0].num_cores = 2;
+	corpora[1].name = "medium";
+	corpora[1].num_tasks = 10;
+	corpora[1].num_cores = 4;
+	corpora[2].name = "large";
+	corpora[2].num_tasks = 30;
+	corpora[2].num_cores = 8;
+
+	std::vector<bench_result_t> results;
+	for (unsigned int c = 0; c < 3; c++)
+	{
+		corpora[c].utilization = 0.5*corpora[c].num_cores;
+		build_corpus(corpora[c], c);
+		bench_corpus(corpora[c], results);
+	}
+
+	*out << "kernel,corpus,ops,ns_per_op,min_ns_per_op,allocs_per_op,bytes_per_op,checksum\n";
+	for (unsigned int index = 0; index < results.size(); index++)
+	{
+		const bench_result_t &result = results[index];
+		*out << result.kernel << "," << result.corpus << "," << result.ops << "," << std::fixed << std::setprecision(1) 
+			 << result.ns_per_op << "," << result.min_ns_per_op << "," << std::setprecision(2) << result.allocs_per_op << "," 
+			 << result.bytes_per_op << "," << std::defaultfloat << std::setprecision(12) << result.checksum << "\n";
+	}
+	if (outfile.is_open())
+		outfile.close();
+
+	// Speedups over the baseline, a changed checksum means the kernel no longer computes the same results
+	if (!baseline.empty())
+	{
+		int changed = 0;
+		std::cout << "Kernel/Corpus: ns/op (baseline, speedup), allocs/op (baseline), checksum\n";
+		for (unsigned int index = 0; index < results.size(); index++)
+		{
+			const bench_result_t &result = results[index];
+			std::map<std::string, bench_result_t>::const_iterator it = baseline.find(result.kernel + "/" + result.corpus);
+			if (it == baseline.end())
+				continue;
+			bool same = std::fabs(result.checksum - it->second.checksum) <= 1e-9*std::max(1.0, std::fabs(it->second.checksum));
+			changed += same ? 0 : 1;
+			std::cout << result.kernel << "/" << result.corpus << ": " << std::fixed << std::setprecision(1) << result.ns_per_op 
+					  << " (" << it->second.ns_per_op << ", " << std::setprecision(2) << it->second.ns_per_op/result.ns_per_op << "x), " 
+					  << result.allocs_per_op << " (" << it->second.allocs_per_op << "), " << (same ? "same" : "CHANGED") << "\n";
+		}
+		if (changed > 0)
+			return 1;
+	}
+	return 0;
+}
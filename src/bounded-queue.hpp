@@ -0,0 +1,134 @@
+/*
+ * @file bounded-queue.hpp
+ * @brief Bounded lock-free multi-producer multi-consumer queue
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+/* Ring of cells with per-cell sequence numbers (Vyukov's bounded MPMC queue): producers and consumers
+   claim a position with a CAS and never wait on each other, a full or empty ring just fails the call;
+   items are swapped in and out, so the storage of a spent item goes back to the caller for reuse */
+template <typename T>
+class BoundedQueue
+{
+	// Constructor (the capacity is rounded up to a power of two)
+	public: BoundedQueue(size_t capacity)
+	{
+		size_t size = 1;
+		while (size < capacity)
+			size = size << 1;
+
+		cells.reset(new cell_t[size]);
+		mask = size - 1;
+		for (size_t index = 0; index < size; index++)
+			cells[index].sequence.store(index, std::memory_order_relaxed);
+		enqueue_pos.store(0, std::memory_order_relaxed);
+		dequeue_pos.store(0, std::memory_order_relaxed);
+	}
+
+	// Swap an item in (item is left with the cell's spent item), false if the ring is full
+	public: bool tryPush(T &item)
+	{
+		cell_t *cell;
+		size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t) sequence - (intptr_t) pos;
+			if (diff == 0)
+			{
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+		}
+		std::swap(cell->data, item);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Swap an item out (the cell keeps the caller's spent item), false if the ring is empty
+	public: bool tryPop(T &item)
+	{
+		cell_t *cell;
+		size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t) sequence - (intptr_t) (pos + 1);
+			if (diff == 0)
+			{
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+		}
+		std::swap(item, cell->data);
+		cell->sequence.store(pos + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Get the number of queued items (a snapshot, the other threads keep going)
+	public: size_t size() const
+	{
+		size_t enqueued = enqueue_pos.load(std::memory_order_relaxed);
+		size_t dequeued = dequeue_pos.load(std::memory_order_relaxed);
+		return (enqueued > dequeued) ? (enqueued - dequeued) : 0;
+	}
+
+	// Get the capacity of the ring
+	public: size_t capacity() const
+	{
+		return mask + 1;
+	}
+
+	// Private Variables
+	private: struct cell_t
+	{
+		std::atomic<size_t> sequence;
+		T data;
+	};
+	private: std::unique_ptr<cell_t[]> cells;
+	private: size_t mask;
+	private: alignas(64) std::atomic<size_t> enqueue_pos;    // own cache lines, producers and consumers do not share them
+	private: alignas(64) std::atomic<size_t> dequeue_pos;
+};
+
+#endif
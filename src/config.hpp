@@ -31,12 +31,19 @@
 #define DEBUG 0
 
 // Taskset Generation Configuration
+// -> the task and period bounds, the hyperperiod cap and the GPU fraction granularity are the defaults of the runtime
+//    configuration (sched-config.hpp), the drivers override them with --config <key>=<value> and --config-file <file>
 #define CPU_TASK_UPPER_BOUND 0.4	/* Upper bound on the CPU task utilization */
 #define GPU_TASK_UPPER_BOUND 0.4    /* Upper bound on the GPU task utilization */
 #define CPU_INTERVENTION_UTIL 0.1   /* Upper bound on the CPU intervention required for the GPU */
 #define CPU_INTERVENTION_BOUND 1    /* Time upper bound on the CPU intervention of the GPU segment */
 #define MIN_PERIOD 5				/* Minimum Task Period */
 #define MAX_PERIOD 500				/* Maximum Task Period */
+#define HYPERPERIOD_CAP 10000       /* Upper bound on the hyperperiod of divisor-rich periods (harmonic flag 2) */
+#define HYPERPERIOD_LIMIT 1000000000ULL /* Hyperperiods above it are reported as too large */
+#define UTIL_SAMPLER_UUNIFAST 0     /* Task utilization samplers: UUniFast-Discard */
+#define UTIL_SAMPLER_RANDFIXEDSUM 1 /*                            RandFixedSum */
+#define UTIL_SAMPLER UTIL_SAMPLER_RANDFIXEDSUM /* Sampler of the task utilizations */
 #define MAX_TASKS 10			    /* Maximum number of tasks */
 #define MAX_TASKS_MC4 15            /* Maximum tasks for 4 cores */
 #define GPU_FRACTION_GRANULARITY 10 /* Maximum segments the GPU can be broken into */
@@ -44,6 +51,58 @@
 #define MAX_GPU_FRACTION 1.0        /* Maximum GPU Fraction           */
 #define FRACTION_TASKS_GPU 0.5      /* Fraction of tasks with GPU segments */
 
+// Local-Search Partitioning Configuration
+#define LS_MAX_ITERATIONS 200       /* Moves tried per local-search restart */
+#define LS_INITIAL_TEMPERATURE 1.0  /* Initial simulated-annealing temperature */
+#define LS_COOLING_RATE 0.97        /* Geometric cooling factor per move */
+#define LS_SWAP_PROBABILITY 0.3     /* Probability of swapping instead of moving a task */
+#define LS_EXPLORE_PROBABILITY 0.2  /* Probability of moving to a random core instead of the one with most slack */
+
+// Semi-Partitioning Configuration
+#define SPLIT_SEARCH_STEPS 8        /* Bisection steps for the largest head budget a core accepts */
+#define SPLIT_BACKOFF_STEPS 4       /* Head budgets tried per tail core, shrinking from the largest one */
+
+// Schedulability Verdict Cache Configuration
+#define SCHED_CACHE_MAX_ENTRIES 4096 /* Bound on the cached (taskset, mapping, test) verdicts, 0 disables the cache */
+
+// Generation/Analysis Pipeline Configuration
+#define PIPELINE_QUEUE_DEPTH 64     /* Capacity of the rings between the pipeline stages */
+#define PIPELINE_GENERATORS 2       /* Number of taskset generator threads */
+#define PIPELINE_GENERATION_BATCH 16 /* Tasksets a generator thread claims and generates into its arena at once */
+
+// Checkpoint Configuration
+#define CHECKPOINT_INTERVAL 100     /* Tasksets analysed between two checkpoints of a run */
+#define CHECKPOINT_VERSION 1        /* Layout version of the checkpoint file */
+
+// Sequential Sampling Configuration
+#define CI_CONFIDENCE_Z 1.96        /* Normal quantile of the intervals (95% confidence) */
+#define CI_MIN_TASKSETS 100         /* Tasksets analysed before the intervals are checked */
+
+// Result Log Configuration
+#define RESULT_LOG_ROWS_PER_GROUP 1024 /* Tasksets buffered per row group of the result log */
+
+// Simulation Configuration
+#define SIM_MAX_HORIZON 1000000     /* Simulated time when the hyperperiod is larger */
+#define SIM_BCET_RATIO 0.5          /* Shortest execution of a phase relative to its WCET (random execution times) */
+#define SIM_HISTOGRAM_RESOLUTION 0.001 /* Relative width of the response-time histogram buckets */
+#define SIM_HISTOGRAM_FLOOR 0.001   /* Response times below it share the first histogram bucket */
+
+// Soundness Harness Configuration
+#define SOUNDNESS_REPRODUCERS_PER_TEST 1 /* Violations of a test shrunk to a reproducer, the later ones are only counted */
+#define SOUNDNESS_MAX_SHRINK_STEPS 500   /* Candidate tasksets simulated while shrinking one violation */
+
+// Benchmark Configuration
+#define BENCH_CORPUS_TASKSETS 16    /* Tasksets in each benchmark corpus (small, medium and large) */
+#define BENCH_WARMUP_RUNS 2         /* Untimed passes over a corpus before the timed ones */
+#define BENCH_RUNS 7                /* Timed passes over a corpus, the median is reported */
+#define BENCH_SEED 1                /* Seed of the taskset streams of the corpora */
+#define BENCH_SCALING_MAX_TASKS 80  /* Last task count of the scalability sweep (doubling from 5) */
+#define BENCH_SCALING_MAX_SEGMENTS 20 /* Last segment count per GPU task of the scalability sweep (doubling from 1) */
+#define BENCH_SCALING_BASE_TASKS 40 /* Task count of the segment sweep */
+#define BENCH_SCALING_CORES 8       /* Cores of the scalability tasksets, half loaded */
+#define BENCH_SCALING_TASKSETS 4    /* Tasksets per point of the scalability sweep */
+#define BENCH_SCALING_MIN_TIME 0.05 /* Seconds of analysis measured per test and point */
+
 // Floating point errors overflow compensation
 #define EPSILON_FLO 0.001           /* Term to compensate for ceil floor floating point errors*/
 
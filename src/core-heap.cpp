@@ -0,0 +1,196 @@
+/*
+ * @file core-heap.cpp
+ * @brief Indexed min-heap of core utilizations implementation
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <cstdint>
+
+// Include Internal Headers
+#include "core-heap.hpp"
+
+// Constructor
+CoreUtilHeap::CoreUtilHeap(unsigned int num_cores, unsigned int first_core)
+{
+	core_util.resize(num_cores, 0.0);
+	heap_pos.resize(num_cores, -1);
+	exclusion_mask.resize((num_cores + 63)/64, 0);
+	num_excluded = 0;
+
+	// All utilizations are equal, so the cores in id order already form a heap
+	for (unsigned int core = first_core; core < num_cores; core++)
+	{
+		heap_pos[core] = heap.size();
+		heap.push_back(core);
+	}
+}
+
+// Destructor
+CoreUtilHeap::~CoreUtilHeap()
+{
+	return;
+}
+
+unsigned int CoreUtilHeap::getMinCore() const
+{
+	if (heap.empty())
+		return 0;
+	return heap[0];
+}
+
+double CoreUtilHeap::getUtil(unsigned int core) const
+{
+	if (core >= core_util.size())
+		return -1;
+	return core_util[core];
+}
+
+int CoreUtilHeap::addUtil(unsigned int core, double util)
+{
+	if (core >= core_util.size())
+		return -1;
+
+	core_util[core] = core_util[core] + util;
+	if (heap_pos[core] >= 0)
+	{
+		siftUp(heap_pos[core]);
+		siftDown(heap_pos[core]);
+	}
+	return 0;
+}
+
+int CoreUtilHeap::exclude(unsigned int core)
+{
+	if (core >= core_util.size() || isExcluded(core))
+		return -1;
+
+	exclusion_mask[core/64] |= (uint64_t(1) << (core%64));
+	num_excluded++;
+	if (heap_pos[core] >= 0)
+		removeCore(core);
+	return 0;
+}
+
+void CoreUtilHeap::clearExclusions()
+{
+	uint64_t word;
+	unsigned int core;
+
+	if (num_excluded == 0)
+		return;
+
+	// Walk the set bits only
+	for (unsigned int w = 0; w < exclusion_mask.size(); w++)
+	{
+		word = exclusion_mask[w];
+		while (word != 0)
+		{
+			core = 64*w + __builtin_ctzll(word);
+			word = word & (word - 1);
+			insertCore(core);
+		}
+		exclusion_mask[w] = 0;
+	}
+	num_excluded = 0;
+}
+
+bool CoreUtilHeap::isExcluded(unsigned int core) const
+{
+	return (exclusion_mask[core/64] >> (core%64)) & 1;
+}
+
+unsigned int CoreUtilHeap::getNumExcluded() const
+{
+	return num_excluded;
+}
+
+bool CoreUtilHeap::lessThan(unsigned int core_a, unsigned int core_b) const
+{
+	if (core_util[core_a] != core_util[core_b])
+		return core_util[core_a] < core_util[core_b];
+	return core_a < core_b;
+}
+
+void CoreUtilHeap::siftUp(unsigned int pos)
+{
+	unsigned int core = heap[pos];
+	unsigned int parent;
+
+	while (pos > 0)
+	{
+		parent = (pos - 1)/2;
+		if (!lessThan(core, heap[parent]))
+			break;
+		heap[pos] = heap[parent];
+		heap_pos[heap[pos]] = pos;
+		pos = parent;
+	}
+	heap[pos] = core;
+	heap_pos[core] = pos;
+}
+
+void CoreUtilHeap::siftDown(unsigned int pos)
+{
+	unsigned int core = heap[pos];
+	unsigned int child;
+
+	while (2*pos + 1 < heap.size())
+	{
+		child = 2*pos + 1;
+		if (child + 1 < heap.size() && lessThan(heap[child + 1], heap[child]))
+			child++;
+		if (!lessThan(heap[child], core))
+			break;
+		heap[pos] = heap[child];
+		heap_pos[heap[pos]] = pos;
+		pos = child;
+	}
+	heap[pos] = core;
+	heap_pos[core] = pos;
+}
+
+void CoreUtilHeap::insertCore(unsigned int core)
+{
+	heap_pos[core] = heap.size();
+	heap.push_back(core);
+	siftUp(heap_pos[core]);
+}
+
+void CoreUtilHeap::removeCore(unsigned int core)
+{
+	unsigned int pos = heap_pos[core];
+	unsigned int last = heap.back();
+
+	heap.pop_back();
+	heap_pos[core] = -1;
+	if (last == core)
+		return;
+
+	// Move the last core into the hole and restore the heap order
+	heap[pos] = last;
+	heap_pos[last] = pos;
+	siftUp(pos);
+	siftDown(heap_pos[last]);
+}
@@ -0,0 +1,71 @@
+/*
+ * @file core-heap.hpp
+ * @brief Indexed min-heap of core utilizations header
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CORE_HEAP_HPP
+#define CORE_HEAP_HPP
+
+#include <vector>
+#include <cstdint>
+
+/* Indexed min-heap of the core utilizations with an exclusion bitmask,
+   selection and exclusion of a core cost O(log cores) */
+class CoreUtilHeap
+{
+	// Constructor and destructor (cores below first_core are never selected)
+	public: CoreUtilHeap(unsigned int num_cores, unsigned int first_core);
+	public: ~CoreUtilHeap();
+
+	// Get the non-excluded core with the minimum utilization (ties -> lowest core id)
+	// -> returns 0 if every core is excluded, as the linear scan did
+	public: unsigned int getMinCore() const;
+
+	// Get/Add the utilization of a core
+	public: double getUtil(unsigned int core) const;
+	public: int addUtil(unsigned int core, double util);
+
+	// Exclude a core from the selection, re-admit all excluded cores
+	public: int exclude(unsigned int core);
+	public: void clearExclusions();
+	public: bool isExcluded(unsigned int core) const;
+	public: unsigned int getNumExcluded() const;
+
+	// Heap maintenance
+	private: bool lessThan(unsigned int core_a, unsigned int core_b) const;
+	private: void siftUp(unsigned int pos);
+	private: void siftDown(unsigned int pos);
+	private: void insertCore(unsigned int core);
+	private: void removeCore(unsigned int core);
+
+	// Private Variables
+	private: std::vector<double> core_util;
+	private: std::vector<unsigned int> heap;          // core ids, heap ordered by (utilization, core id)
+	private: std::vector<int> heap_pos;               // position of each core in the heap, -1 if not in it
+	private: std::vector<uint64_t> exclusion_mask;    // one bit per core
+	private: unsigned int num_excluded;
+};
+
+#endif
@@ -59,7 +59,7 @@ double calculate_prioritized_blocking_fifo_hybrid_conc(unsigned int index, doubl
 		// Calculate the prioritized blocking due to this lp task
 		phi = 0;
 		phi_sum = 0;
-		Gm_max = find_next_task_max_gpu_intervention_segment(i, double(MAX_PERIOD+1), num_biggest, task_vector);
+		Gm_max = find_next_task_max_gpu_intervention_segment(i, SEGMENT_SEARCH_UNBOUNDED, num_biggest, task_vector);
 		while (num_gpu_segments + 1 - phi_sum > 0 && Gm_max > 0)
 		{
 			if (theta < num_gpu_segments + 1 - phi_sum)
@@ -161,9 +161,9 @@ double calculate_interference_fifo(unsigned int index, const std::vector<Task> &
 			continue;
 
 		if (task_vector[i].getTotalGe() != 0)
-			interference = interference + ceil((resp_time + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
+			interference = interference + ceil((resp_time + task_vector[i].getJ() + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
 		else
-			interference = interference + ceil((resp_time)/task_vector[i].getT())*(task_vector[i].getC());
+			interference = interference + ceil((resp_time + task_vector[i].getJ())/task_vector[i].getT())*(task_vector[i].getC());
 	}
 	return interference;
 }
@@ -201,7 +201,7 @@ std::vector<double> calculate_hp_resp_time_fifo(unsigned int index, const std::v
 }
 
 /**************** Calculate Schedulability using FIFO on the concurrent GPU ********************/ 
-int check_schedulability_fifo_conc(std::vector<Task> &task_vector)
+int check_schedulability_fifo_conc(std::vector<Task> &task_vector, std::vector<double> &resp_time)
 {
 	// Pre-compute the response-time of each GPU segment
 	pre_compute_gpu_response_time(task_vector);
@@ -210,7 +210,7 @@ int check_schedulability_fifo_conc(std::vector<Task> &task_vector)
 		printf("FIFO Policy on the GPU Approach\n");
 
 	// Do the schedulability test
-	std::vector<double> resp_time = calculate_hp_resp_time_fifo(task_vector.size(), task_vector);
+	resp_time = calculate_hp_resp_time_fifo(task_vector.size(), task_vector);
 
 	for (unsigned int index = 0; index < task_vector.size(); index++) 
 	{
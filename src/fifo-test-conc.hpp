@@ -35,7 +35,14 @@
 
 /**************** Calculate Schedulability using the FIFO Approach ********************/ 
 /* Params: task_vector: vector of tasks 
+		   resp_time: vector of response times of each task (is populated on the return)
    Returns: 0 if schedulable */
-int check_schedulability_fifo_conc(std::vector<Task> &task_vector);
+int check_schedulability_fifo_conc(std::vector<Task> &task_vector, std::vector<double> &resp_time);
+
+/**************** The Calculate High-Priority response time sub-routine using the FIFO approach ********************/ 
+/* Params: index: number of highest-priority tasks to analyse (tasks are in priority order)
+		   task_vector: vector of tasks 
+   Returns: response times of the first index tasks */
+std::vector<double> calculate_hp_resp_time_fifo(unsigned int index, const std::vector<Task> &task_vector);
 
 #endif
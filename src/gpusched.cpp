@@ -0,0 +1,299 @@
+/*
+ * @file gpusched.cpp
+ * @brief C interface of the schedulability analysis, for online admission control
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Standard Library Imports */
+#include <vector>
+#include <new>
+#include <algorithm>
+#include <atomic>
+
+/* Internal Headers */
+#include "gpusched.h"
+#include "task.hpp"
+#include "taskset.hpp"
+#include "task_partitioning.hpp"
+#include "core-heap.hpp"
+#include "sched-config.hpp"
+#include "config.hpp"
+
+static_assert(int(GPUSCHED_FIFO_CONC) == int(FIFO_CONC) && int(GPUSCHED_REQUEST_DRIVEN) == int(REQUEST_DRIVEN),
+			  "gpusched_test_t must keep the values of sched_type");
+
+// Comparator class for ordering tasks using RMS
+struct CompareTaskPriorityRMS {
+    bool operator()(Task const & t1, Task const & t2) {
+        // return "true" if "t1" has higher RMS priority than "t2"
+        return t1.getT() < t2.getT();
+    }
+} ComparePriorityRMS;
+
+// Admitted tasks of a handle, task_vector, task_ids and resp_time are kept aligned
+struct gpusched_taskset {
+	gpusched_taskset(int cores, sched_type mode) : num_cores(cores), sched_mode(mode), max_probes(0), next_id(0), core_heap(cores, 0) {}
+
+	int num_cores;
+	sched_type sched_mode;
+	unsigned int max_probes;		// cores tried per admission, 0 = all
+	int next_id;
+	std::vector<Task> task_vector;	// admitted tasks in priority order, mapped to their cores
+	std::vector<int> task_ids;		// id of each admitted task
+	std::vector<double> resp_time;	// response time of each admitted task
+	CoreUtilHeap core_heap;			// CPU utilization of each core
+};
+
+// Handles not yet destroyed, the configuration is frozen while any exists
+static std::atomic<int> num_tasksets(0);
+
+/**************** Find the position of a task id ********************/ 
+static int find_task(const gpusched_taskset_t *taskset, int task_id)
+{
+	for (unsigned int index = 0; index < taskset->task_ids.size(); index++)
+	{
+		if (taskset->task_ids[index] == task_id)
+			return index;
+	}
+	return -1;
+}
+
+/**************** CPU utilization of a task on its core, as seen by WFD ********************/ 
+static double get_core_util(const Task &task)
+{
+	return (task.getC()+task.getTotalGm())/task.getT();
+}
+
+int gpusched_get_api_version(void)
+{
+	return GPUSCHED_API_VERSION;
+}
+
+const char *gpusched_get_test_name(int test)
+{
+	if (test < 0 || test >= INVALID)
+		return NULL;
+	return sched_type_names[test];
+}
+
+int gpusched_set_config(const char *assignment)
+{
+	if (assignment == NULL)
+		return GPUSCHED_EINVAL;
+	if (num_tasksets.load() > 0)
+		return GPUSCHED_EBUSY;
+
+	try
+	{
+		if (apply_sched_config(assignment) != 0)
+			return GPUSCHED_EINVAL;
+	}
+	catch (const std::bad_alloc &)
+	{
+		return GPUSCHED_ENOMEM;
+	}
+	return GPUSCHED_OK;
+}
+
+gpusched_taskset_t *gpusched_taskset_create(int num_cores, gpusched_test_t test)
+{
+	if (num_cores <= 0 || int(test) < 0 || int(test) >= INVALID)
+		return NULL;
+
+	try
+	{
+		gpusched_taskset_t *taskset = new gpusched_taskset_t(num_cores, (sched_type) test);
+		num_tasksets++;
+		return taskset;
+	}
+	catch (const std::bad_alloc &)
+	{
+		return NULL;
+	}
+}
+
+void gpusched_taskset_destroy(gpusched_taskset_t *taskset)
+{
+	if (taskset == NULL)
+		return;
+
+	delete taskset;
+	num_tasksets--;
+}
+
+int gpusched_set_max_probes(gpusched_taskset_t *taskset, unsigned int max_probes)
+{
+	if (taskset == NULL)
+		return GPUSCHED_EINVAL;
+
+	taskset->max_probes = max_probes;
+	return GPUSCHED_OK;
+}
+
+int gpusched_add_task(gpusched_taskset_t *taskset, const gpusched_task_t *task, int *task_id)
+{
+	task_t task_params;
+	gpu_params_t G;
+
+	if (taskset == NULL || task == NULL || task_id == NULL || (task->num_segments > 0 && task->segments == NULL))
+		return GPUSCHED_EINVAL;
+
+	// Same checks as the taskset loader (written to also reject NaNs)
+	if (!(task->C >= 0) || !(task->T > 0) || !(task->D > 0) || !(task->D <= task->T))
+		return GPUSCHED_EINVAL;
+	for (unsigned int i = 0; i < task->num_segments; i++)
+	{
+		if (!(task->segments[i].Gm >= 0) || !(task->segments[i].Ge >= 0) || !(task->segments[i].F > 0) || !(task->segments[i].F <= 1))
+			return GPUSCHED_EINVAL;
+	}
+
+	try
+	{
+		task_params.C = task->C;
+		task_params.D = task->D;
+		task_params.T = task->T;
+		for (unsigned int i = 0; i < task->num_segments; i++)
+		{
+			G.Gm = task->segments[i].Gm;
+			G.Ge = task->segments[i].Ge;
+			G.F = task->segments[i].F;
+			task_params.G.push_back(G);
+		}
+		Task new_task(task_params);
+		double task_util = get_core_util(new_task);
+
+		// Candidate taskset, the new task after the admitted tasks of the same priority
+		std::vector<Task> candidate = taskset->task_vector;
+		unsigned int position = std::upper_bound(candidate.begin(), candidate.end(), new_task, ComparePriorityRMS) - candidate.begin();
+		candidate.insert(candidate.begin() + position, new_task);
+		std::vector<double> resp_time;
+
+		unsigned int num_probes = taskset->num_cores;
+		if (taskset->max_probes > 0 && taskset->max_probes < num_probes)
+			num_probes = taskset->max_probes;
+
+		// Worst-fit over the cores, the admitted tasks keep their mapping -> at most num_probes runs of the test
+		taskset->core_heap.clearExclusions();
+		for (unsigned int probe = 0; probe < num_probes; probe++)
+		{
+			unsigned int chosen_core = taskset->core_heap.getMinCore();
+
+			// The least utilized core is overloaded -> so is every other core
+			if (taskset->core_heap.getUtil(chosen_core) + task_util > 1)
+				break;
+
+			candidate[position].setCoreID(chosen_core);
+			if (get_partition_response_times(candidate, taskset->sched_mode, resp_time) == 0)
+			{
+				taskset->task_ids.insert(taskset->task_ids.begin() + position, taskset->next_id);
+				taskset->task_vector.swap(candidate);
+				taskset->resp_time.swap(resp_time);
+				taskset->core_heap.addUtil(chosen_core, task_util);
+				taskset->core_heap.clearExclusions();
+				*task_id = taskset->next_id++;
+				return GPUSCHED_OK;
+			}
+			taskset->core_heap.exclude(chosen_core);
+		}
+		taskset->core_heap.clearExclusions();
+	}
+	catch (const std::bad_alloc &)
+	{
+		// Nothing is committed before the last allocation (the id insertion)
+		taskset->core_heap.clearExclusions();
+		return GPUSCHED_ENOMEM;
+	}
+	return GPUSCHED_UNSCHEDULABLE;
+}
+
+int gpusched_remove_task(gpusched_taskset_t *taskset, int task_id)
+{
+	if (taskset == NULL)
+		return GPUSCHED_EINVAL;
+
+	int index = find_task(taskset, task_id);
+	if (index < 0)
+		return GPUSCHED_ENOENT;
+
+	taskset->core_heap.addUtil(taskset->task_vector[index].getCoreID(), -get_core_util(taskset->task_vector[index]));
+	taskset->task_vector.erase(taskset->task_vector.begin() + index);
+	taskset->task_ids.erase(taskset->task_ids.begin() + index);
+	taskset->resp_time.erase(taskset->resp_time.begin() + index);
+
+	if (taskset->task_vector.empty())
+		return GPUSCHED_OK;
+
+	// Refresh the response times, the analyses are not all sustainable so the verdict is checked too
+	try
+	{
+		std::vector<double> resp_time;
+		int sched_flag = get_partition_response_times(taskset->task_vector, taskset->sched_mode, resp_time);
+		if (resp_time.size() == taskset->task_vector.size())
+			taskset->resp_time.swap(resp_time);
+		if (sched_flag != 0)
+			return GPUSCHED_UNSCHEDULABLE;
+	}
+	catch (const std::bad_alloc &)
+	{
+		// The task is removed, the other response times are those before the removal
+		return GPUSCHED_ENOMEM;
+	}
+	return GPUSCHED_OK;
+}
+
+unsigned int gpusched_get_num_tasks(const gpusched_taskset_t *taskset)
+{
+	if (taskset == NULL)
+		return 0;
+	return taskset->task_vector.size();
+}
+
+int gpusched_get_task(const gpusched_taskset_t *taskset, int task_id, unsigned int *core, double *resp_time)
+{
+	if (taskset == NULL)
+		return GPUSCHED_EINVAL;
+
+	int index = find_task(taskset, task_id);
+	if (index < 0)
+		return GPUSCHED_ENOENT;
+
+	if (core != NULL)
+		*core = taskset->task_vector[index].getCoreID();
+	if (resp_time != NULL)
+		*resp_time = taskset->resp_time[index];
+	return GPUSCHED_OK;
+}
+
+int gpusched_get_utilization(const gpusched_taskset_t *taskset, double *cpu_util, double *gpu_util)
+{
+	if (taskset == NULL)
+		return GPUSCHED_EINVAL;
+
+	if (cpu_util != NULL)
+		*cpu_util = get_taskset_cpu_util(taskset->task_vector);
+	if (gpu_util != NULL)
+		*gpu_util = get_taskset_gpu_util(taskset->task_vector);
+	return GPUSCHED_OK;
+}
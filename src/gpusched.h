@@ -0,0 +1,155 @@
+/*
+ * @file gpusched.h
+ * @brief C interface of the schedulability analysis, for online admission control
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef GPUSCHED_H
+#define GPUSCHED_H
+
+/* C interface of the analysis (libgpusched.a, libgpusched.so): a taskset handle admits and removes
+   tasks one at a time, the admitted tasks stay on their cores and remain schedulable under the chosen test.
+   A handle is not thread-safe, use one handle per thread or serialize the calls on it. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Version of the interface, bumped on an incompatible change */
+#define GPUSCHED_API_VERSION 1
+
+/* Return codes */
+#define GPUSCHED_OK 				0	/* success, the task was admitted */
+#define GPUSCHED_UNSCHEDULABLE 		1	/* the task was rejected (the taskset is unchanged) */
+#define GPUSCHED_EINVAL 			-1	/* invalid argument */
+#define GPUSCHED_ENOENT 			-2	/* unknown task id */
+#define GPUSCHED_ENOMEM 			-3	/* out of memory (the taskset is unchanged) */
+#define GPUSCHED_EBUSY 				-4	/* a taskset exists (the configuration cannot change) */
+
+/* Schedulability tests, same values as sched_type */
+typedef enum gpusched_test {
+	GPUSCHED_REQUEST_DRIVEN 			= 0,
+	GPUSCHED_JOB_DRIVEN 				= 1,
+	GPUSCHED_HYBRID 					= 2,
+	GPUSCHED_REQUEST_DRIVEN_CONC_SIMPLE = 3,
+	GPUSCHED_JOB_DRIVEN_CONC 			= 4,
+	GPUSCHED_REQUEST_DRIVEN_CONC 		= 5,
+	GPUSCHED_JOB_DRIVEN_CONC_RO 		= 6,
+	GPUSCHED_HYBRID_CONC 				= 7,
+	GPUSCHED_FIFO_CONC 					= 8
+} gpusched_test_t;
+
+/* GPU segment of a task */
+typedef struct gpusched_segment {
+	double Gm;		/* WCET CPU intervention */
+	double Ge;		/* WCET GPU execution */
+	double F;		/* Fraction of the GPU used (0 < F <= 1) */
+} gpusched_segment_t;
+
+/* Task parameters, the priorities are rate-monotonic */
+typedef struct gpusched_task {
+	double C;								/* WCET on CPU */
+	double D;								/* Deadline (0 < D <= T) */
+	double T;								/* Period */
+	const gpusched_segment_t *segments;		/* GPU segments, in execution order (NULL if none) */
+	unsigned int num_segments;
+} gpusched_task_t;
+
+/* Opaque taskset handle */
+typedef struct gpusched_taskset gpusched_taskset_t;
+
+/**************** Get the version of the interface ********************/ 
+/* Returns: GPUSCHED_API_VERSION of the library */
+int gpusched_get_api_version(void);
+
+/**************** Get the name of a schedulability test ********************/ 
+/* Returns: name of the test, NULL if test is not a gpusched_test_t */
+const char *gpusched_get_test_name(int test);
+
+/**************** Set a configuration value ********************/ 
+/* Shared by all the handles, so it can only be set while no taskset exists (the admitted tasks were
+   analysed under the current configuration)
+   Params: assignment: <key>=<value>, see sched-config.hpp for the keys
+   Returns: GPUSCHED_OK, GPUSCHED_EINVAL on an unknown key or an invalid value, GPUSCHED_EBUSY if a taskset exists */
+int gpusched_set_config(const char *assignment);
+
+/**************** Create an empty taskset ********************/ 
+/* Params: num_cores: number of CPU cores
+		   test     : schedulability test used to admit the tasks
+   Returns: the handle, NULL on an invalid argument or if out of memory */
+gpusched_taskset_t *gpusched_taskset_create(int num_cores, gpusched_test_t test);
+
+/**************** Destroy a taskset ********************/ 
+/* Params: taskset: handle (may be NULL) */
+void gpusched_taskset_destroy(gpusched_taskset_t *taskset);
+
+/**************** Bound the number of cores tried per admission ********************/ 
+/* An admission runs the test once per core tried, least utilized core first
+   Params: taskset   : handle
+		   max_probes: cores tried per admission, 0 tries every core (the default)
+   Returns: GPUSCHED_OK, GPUSCHED_EINVAL */
+int gpusched_set_max_probes(gpusched_taskset_t *taskset, unsigned int max_probes);
+
+/**************** Admit a task ********************/ 
+/* The admitted tasks keep their cores, the new task goes to the least utilized core that keeps the
+   taskset schedulable (worst-fit)
+   Params: taskset: handle
+		   task   : task parameters (the segments are copied)
+		   task_id: id of the admitted task (populated by this function, ids are not reused)
+   Returns: GPUSCHED_OK if admitted, GPUSCHED_UNSCHEDULABLE if rejected, GPUSCHED_EINVAL, GPUSCHED_ENOMEM */
+int gpusched_add_task(gpusched_taskset_t *taskset, const gpusched_task_t *task, int *task_id);
+
+/**************** Remove a task ********************/ 
+/* The response times of the remaining tasks are recomputed
+   Params: taskset: handle
+		   task_id: id returned by gpusched_add_task
+   Returns: GPUSCHED_OK, GPUSCHED_UNSCHEDULABLE if the test no longer accepts the remaining tasks (the task is
+			removed anyway), GPUSCHED_ENOENT, GPUSCHED_EINVAL, GPUSCHED_ENOMEM */
+int gpusched_remove_task(gpusched_taskset_t *taskset, int task_id);
+
+/**************** Get the number of admitted tasks ********************/ 
+/* Returns: number of tasks, 0 if taskset is NULL */
+unsigned int gpusched_get_num_tasks(const gpusched_taskset_t *taskset);
+
+/**************** Get the core and the response time of an admitted task ********************/ 
+/* Params: taskset  : handle
+		   task_id  : id returned by gpusched_add_task
+		   core     : core of the task (populated by this function, may be NULL)
+		   resp_time: worst-case response time of the task under the test (populated by this function, may be NULL)
+   Returns: GPUSCHED_OK, GPUSCHED_ENOENT, GPUSCHED_EINVAL */
+int gpusched_get_task(const gpusched_taskset_t *taskset, int task_id, unsigned int *core, double *resp_time);
+
+/**************** Get the utilization of the admitted tasks ********************/ 
+/* Params: taskset : handle
+		   cpu_util: CPU utilization (populated by this function, may be NULL)
+		   gpu_util: GPU utilization (populated by this function, may be NULL)
+   Returns: GPUSCHED_OK, GPUSCHED_EINVAL */
+int gpusched_get_utilization(const gpusched_taskset_t *taskset, double *cpu_util, double *gpu_util);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -59,7 +59,7 @@ double calculate_prioritized_blocking_hybrid(unsigned int index, double response
 		// Calculate the prioritized blocking due to this lp task
 		phi = 0;
 		phi_sum = 0;
-		Gm_max = find_next_task_max_gpu_intervention_segment(i, double(MAX_PERIOD+1), num_biggest, task_vector);
+		Gm_max = find_next_task_max_gpu_intervention_segment(i, SEGMENT_SEARCH_UNBOUNDED, num_biggest, task_vector);
 		while (num_gpu_segments + 1 - phi_sum > 0 && Gm_max > 0)
 		{
 			if (theta < num_gpu_segments + 1 - phi_sum)
@@ -218,9 +218,9 @@ double calculate_interference_hybrid(unsigned int index, const std::vector<Task>
 			continue;
 
 		if (task_vector[i].getTotalGe() != 0)
-			interference = interference + ceil((resp_time + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
+			interference = interference + ceil((resp_time + task_vector[i].getJ() + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
 		else
-			interference = interference + ceil((resp_time)/task_vector[i].getT())*(task_vector[i].getC());
+			interference = interference + ceil((resp_time + task_vector[i].getJ())/task_vector[i].getT())*(task_vector[i].getC());
 	}
 	return interference;
 }
@@ -263,7 +263,8 @@ std::vector<double> calculate_hp_resp_time_hybrid(unsigned int index, const std:
 int check_schedulability_hybrid(std::vector<Task> &task_vector,
 								const std::vector<double> &resp_time_rd,
 								const std::vector<double> &resp_time_jd,
-								const std::vector<std::vector<double>> &req_blocking)
+								const std::vector<std::vector<double>> &req_blocking,
+								std::vector<double> &resp_time)
 {
 	//l Pre-compute the response-time of each GPU segment
 	pre_compute_gpu_response_time(task_vector);
@@ -272,8 +273,8 @@ int check_schedulability_hybrid(std::vector<Task> &task_vector,
 		printf("Hybrid Approach\n");
 
 	// Do the schedulability test
-	std::vector<double> resp_time = calculate_hp_resp_time_hybrid(task_vector.size(), task_vector,
-																  resp_time_rd, resp_time_jd, req_blocking);
+	resp_time = calculate_hp_resp_time_hybrid(task_vector.size(), task_vector,
+											  resp_time_rd, resp_time_jd, req_blocking);
 
 	for (unsigned int index = 0; index < task_vector.size(); index++) 
 	{
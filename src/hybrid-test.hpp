@@ -38,10 +38,24 @@
 		    resp_time_rd: vector of response times of each task (using the request-driven approach)
 		    resp_time_jd: vector of response times of each task (using the job-driven approach)
 		    req_blocking: direct blocking faced by individual requests (using the request-driven approach)
+		    resp_time: vector of response times of each task (is populated on the return)
    Returns: 0 if schedulable */
 int check_schedulability_hybrid(std::vector<Task> &task_vector, 
 								const std::vector<double> &resp_time_rd,
 								const std::vector<double> &resp_time_jd,
-								const std::vector<std::vector<double>> &req_blocking);
+								const std::vector<std::vector<double>> &req_blocking,
+								std::vector<double> &resp_time);
+
+/**************** The Calculate High-Priority response time sub-routine using the hybrid approach ********************/ 
+/* Params: index: number of highest-priority tasks to analyse (tasks are in priority order)
+		   task_vector: vector of tasks 
+		   resp_time_rd: response times of the request-driven approach
+		   resp_time_jd: response times of the job-driven approach
+		   req_blocking: per-request direct blocking of the request-driven approach
+   Returns: response times of the first index tasks */
+std::vector<double> calculate_hp_resp_time_hybrid(unsigned int index, const std::vector<Task> &task_vector, 
+												  const std::vector<double> &resp_time_rd,
+												  const std::vector<double> &resp_time_jd,
+												  const std::vector<std::vector<double>> &req_blocking);
 
 #endif
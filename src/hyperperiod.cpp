@@ -1,6 +1,6 @@
 /*
- * @file request-driven-test.cpp
- * @brief Implementing to calculate the hyperperiod for tasks with uint64_teger periods
+ * @file hyperperiod.cpp
+ * @brief Implementing to calculate the hyperperiod for tasks with integer periods
  * @author Anon 
  * 
  * Copyright (c) Anon, 2019. All rights reserved.
@@ -28,7 +28,7 @@
 
 #include "hyperperiod.hpp"
 
-uint64_t gcd(uint64_t a, uint64_t b)
+static uint64_t gcd(uint64_t a, uint64_t b)
 {
     for (;;)
     {
@@ -39,45 +39,50 @@ uint64_t gcd(uint64_t a, uint64_t b)
     }
 }
 
-uint64_t period_lcm(uint64_t a, Task const & t2)
+/* The product is formed on 128 bits, so the check against the limit cannot wrap around
+   Returns: lcm of a and the task period, 0 if above the limit or the period is below 1 */
+static uint64_t period_lcm(uint64_t a, Task const & t2, uint64_t limit)
 {
+    if (t2.getT() < 1)
+        return 0;
     uint64_t b = (uint64_t) floor(t2.getT());
 
-    uint64_t temp = gcd(a, b);
+    unsigned __int128 lcm = (unsigned __int128) (a/gcd(a, b)) * b;
 
-    return temp ? ((a/temp) * b) : 0;
+    return (lcm <= limit) ? (uint64_t) lcm : 0;
 }
 
 /**************** Calculate Task Set hyperperiod ********************/ 
-uint64_t compute_hyperperiod(const std::vector<Task> &task_vector)
+uint64_t compute_hyperperiod(const std::vector<Task> &task_vector, uint64_t limit)
 {
     uint64_t result = 1;
 
-    for (unsigned int i = 0; i < task_vector.size(); i++)
+    // Stop at the first lcm over the limit, the later ones can only be larger
+    for (unsigned int i = 0; i < task_vector.size() && result != 0; i++)
     {
-        result = period_lcm(result, task_vector[i]);
+        result = period_lcm(result, task_vector[i], limit);
     } 
 
     return result;
 }
 
 /**************** Calculate CPU execution time in the hyperperiod ********************/ 
-double compute_cputime_hyperperiod(const std::vector<Task> &task_vector)
+double compute_cputime_hyperperiod(const std::vector<Task> &task_vector, uint64_t limit)
 {
-    uint64_t hyperperiod = compute_hyperperiod(task_vector);
+    uint64_t hyperperiod = compute_hyperperiod(task_vector, limit);
     double cputime = 0;
     int num_gpu_segments;
 
+    if (hyperperiod == 0)
+        return -1;
+
     for (unsigned int i = 0; i < task_vector.size(); i++)
     {
         cputime = cputime + (task_vector[i].getC())*(hyperperiod/floor(task_vector[i].getT()));
-        num_gpu_segments = task_vector[index].getNumGPUSegments();
-        if (num_gpu_segments != 0)
+        num_gpu_segments = task_vector[i].getNumGPUSegments();
+        for (int j = 0; j < num_gpu_segments; j++)
         {
-            for (unsigned int j = 0; j < num_gpu_segments; j++)
-            {
-                cputime = cputime + (task_vector[i].getGm(j))*(hyperperiod/floor(task_vector[i].getT()));
-            }
+            cputime = cputime + (task_vector[i].getGm(j))*(hyperperiod/floor(task_vector[i].getT()));
         }
     }
 
@@ -85,23 +90,23 @@ double compute_cputime_hyperperiod(const std::vector<Task> &task_vector)
 }
 
 /**************** Calculate GPU execution time in the hyperperiod ********************/ 
-double compute_gputime_hyperperiod(const std::vector<Task> &task_vector)
+double compute_gputime_hyperperiod(const std::vector<Task> &task_vector, uint64_t limit)
 {
-    uint64_t hyperperiod = compute_hyperperiod(task_vector);
+    uint64_t hyperperiod = compute_hyperperiod(task_vector, limit);
     double gputime = 0;
     int num_gpu_segments;
 
+    if (hyperperiod == 0)
+        return -1;
+
     for (unsigned int i = 0; i < task_vector.size(); i++)
     {
-        num_gpu_segments = task_vector[index].getNumGPUSegments();
-        if (num_gpu_segments != 0)
+        num_gpu_segments = task_vector[i].getNumGPUSegments();
+        for (int j = 0; j < num_gpu_segments; j++)
         {
-            for (unsigned int j = 0; j < num_gpu_segments; j++)
-            {
-                gputime = gputime + (task_vector[i].getGe(j))*(hyperperiod/floor(task_vector[i].getT()));
-            }
+            gputime = gputime + (task_vector[i].getGe(j))*(hyperperiod/floor(task_vector[i].getT()));
         }
     }
 
     return gputime;
-}
\ No newline at end of file
+}
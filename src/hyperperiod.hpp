@@ -32,21 +32,26 @@
 #include <cstdint>
 
 #include "task.hpp"
+#include "config.hpp"
 
 /**************** Calculate Task Set hyperperiod ********************/ 
-/* Params: task_vector: vector of tasks 
-   Returns: hyperperiod */
-uint64_t compute_hyperperiod(const std::vector<Task> &task_vector);
+/* The periods are floored to integers, the lcm is computed without overflow
+   Params: task_vector: vector of tasks 
+           limit: hyperperiods above it are too large to be of use
+   Returns: hyperperiod, 0 if above the limit or a period is below 1 */
+uint64_t compute_hyperperiod(const std::vector<Task> &task_vector, uint64_t limit = HYPERPERIOD_LIMIT);
 
 /**************** Calculate CPU execution time in the hyperperiod ********************/ 
 /* Params: task_vector: vector of tasks 
-   Returns: cpu execution time in the hyperperiod */
-double compute_cputime_hyperperiod(const std::vector<Task> &task_vector);
+           limit: see compute_hyperperiod
+   Returns: cpu execution time in the hyperperiod, -1 if the hyperperiod is too large */
+double compute_cputime_hyperperiod(const std::vector<Task> &task_vector, uint64_t limit = HYPERPERIOD_LIMIT);
 
 /**************** Calculate GPU execution time in the hyperperiod ********************/ 
 /* Params: task_vector: vector of tasks 
-   Returns: gpu execution time in the hyperperiod */
-double compute_gputime_hyperperiod(const std::vector<Task> &task_vector);
+           limit: see compute_hyperperiod
+   Returns: gpu execution time in the hyperperiod, -1 if the hyperperiod is too large */
+double compute_gputime_hyperperiod(const std::vector<Task> &task_vector, uint64_t limit = HYPERPERIOD_LIMIT);
 
 
 #endif
@@ -35,10 +35,11 @@
 #include "job-driven-test-conc.hpp"
 #include "indirect-cis.hpp"
 #include "taskset.hpp"
+#include "sched-config.hpp"
 #include "config.hpp"
 
-// Request-Oriented flag
-bool request_oriented = false;
+// Request-Oriented flag (per thread, so partitioners may run the test concurrently)
+thread_local bool request_oriented = false;
 
 /**************** Calculate Prioritized Blocking using the job-driven approach sub-routine ********************/ 
 double calculate_prioritized_blocking_jdc(unsigned int index, double response_time, const std::vector<Task> &task_vector)
@@ -72,7 +73,7 @@ double calculate_liquefaction_mass_rojdc(unsigned int index, unsigned int req_in
 	double alpha;
 	unsigned int num_gpu_segments;
 	double fraction = task_vector[index].getF(req_index);
-	double blocking_fraction = 1 - fraction + (1.0/double(GPU_FRACTION_GRANULARITY));
+	double blocking_fraction = 1 - fraction + (get_sched_config().gpu_fraction_unit);
 	double req_fraction;
 
 	// Iterate over all tasks to calculate blocking
@@ -120,10 +121,11 @@ double calculate_direct_blocking_rojdc(unsigned int index, unsigned int &req_ind
 	double liquefied_mass = 0;
 	double wavefront_liquefaction_mass = 0;
 	double liquefied_mass_new = 0;
+	double fraction_unit = get_sched_config().gpu_fraction_unit;
 	int num_biggest = 0;
 	unsigned int max_index;
 
-	double Hl_max = MAX_PERIOD+1; // Set to a large number (MAX_PERIOD is biggest possible)
+	double Hl_max = SEGMENT_SEARCH_UNBOUNDED; // Above any segment, the search starts from the biggest
 	double liquefied_mass_used = 0;
 	unsigned int req_ind;
 
@@ -138,10 +140,10 @@ double calculate_direct_blocking_rojdc(unsigned int index, unsigned int &req_ind
 	{
 		// Get this task fraction
 		fraction = task_vector[index].getF(req_ind);
-		blocking_fraction = 1 - fraction + (1.0/double(GPU_FRACTION_GRANULARITY));
+		blocking_fraction = 1 - fraction + fraction_unit;
 		left_over_fraction = blocking_fraction; 
 
-		Hl_max = MAX_PERIOD+1; // Set to a large number (MAX_PERIOD is biggest possible)
+		Hl_max = SEGMENT_SEARCH_UNBOUNDED; // Above any segment, the search starts from the biggest
 		num_biggest = 0;
 		wavefront_liquefaction_mass = 0;
 		wavefront_req_fraction = 0;
@@ -222,7 +224,7 @@ double calculate_liquefaction_mass_jdc(unsigned int index, double resp_time, con
 	double alpha;
 	unsigned int num_gpu_segments;
 	double fraction = task_vector[index].getMaxF();
-	double blocking_fraction = 1 - fraction + (1.0/double(GPU_FRACTION_GRANULARITY));
+	double blocking_fraction = 1 - fraction + (get_sched_config().gpu_fraction_unit);
 	double req_fraction;
 
 	// Iterate over all tasks to calculate blocking
@@ -261,16 +263,16 @@ double calculate_direct_blocking_jdc(unsigned int index, const std::vector<Task>
 	double init_blocking = 0;
 	unsigned int num_gpu_segments = task_vector[index].getNumGPUSegments();
 	double fraction = task_vector[index].getMaxF();
-	double blocking_fraction = 1 - fraction + (1.0/double(GPU_FRACTION_GRANULARITY));
+	double blocking_fraction = 1 - fraction + (get_sched_config().gpu_fraction_unit);
 	double min_fraction = task_vector[index].getMinF();
-	double blocking_fraction_min = 1 - fraction + (1.0/double(GPU_FRACTION_GRANULARITY));
+	double blocking_fraction_min = 1 - fraction + (get_sched_config().gpu_fraction_unit);
 	double left_over_fraction = blocking_fraction;//blocking_fraction_min;//blocking_fraction;
 	double wavefront_req_fraction = 0;
 	double liquefied_mass = 0 ;
 	double wavefront_liquefaction_mass = 0;
 	int num_biggest = 0;
 
-	double Hl_max = MAX_PERIOD+1; // Set to a large number (MAX_PERIOD is biggest possible)
+	double Hl_max = SEGMENT_SEARCH_UNBOUNDED; // Above any segment, the search starts from the biggest
 
 	// Return 0 blocking if task has no GPU execution
 	if(task_vector[index].getTotalGe() == 0)
@@ -340,9 +342,9 @@ double calculate_interference_jdc(unsigned int index, const std::vector<Task> &t
 			continue;
 
 		if (task_vector[i].getTotalGe() != 0)
-			interference = interference + ceil((resp_time + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
+			interference = interference + ceil((resp_time + task_vector[i].getJ() + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
 		else
-			interference = interference + ceil((resp_time)/task_vector[i].getT())*(task_vector[i].getC());
+			interference = interference + ceil((resp_time + task_vector[i].getJ())/task_vector[i].getT())*(task_vector[i].getC());
 	}
 	return interference;
 }
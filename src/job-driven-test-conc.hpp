@@ -42,4 +42,30 @@
 int check_schedulability_job_driven_conc(std::vector<Task> &task_vector, std::vector<double> &resp_time,
 										 std::vector<double> &direct_blocking, bool ro_job_flag);
 
+/**************** Calculate Liquefaction Mass ********************/ 
+/* Params: index: index of the task under analysis
+		   resp_time: response time of the task under analysis
+		   task_vector: vector of tasks 
+		   resp_time_hp: response times (deadlines for tasks not analysed yet)
+   Returns: GPU mass that can block the job within its response time */
+double calculate_liquefaction_mass_jdc(unsigned int index, double resp_time, const std::vector<Task> &task_vector, 
+									   const std::vector<double> &resp_time_hp);
+
+/**************** Calculate Liquefaction Mass Request-Oriented ********************/ 
+/* Params: index: index of the task under analysis
+		   req_index: index of its GPU request
+		   resp_time: response time of the task under analysis
+		   task_vector: vector of tasks 
+		   resp_time_hp: response times (deadlines for tasks not analysed yet)
+   Returns: GPU mass that can block the request within the response time */
+double calculate_liquefaction_mass_rojdc(unsigned int index, unsigned int req_index, double resp_time, const std::vector<Task> &task_vector, 
+										 const std::vector<double> &resp_time_hp);
+
+/**************** The Calculate High-Priority response time sub-routine using the job-driven approach ********************/ 
+/* Params: index: number of highest-priority tasks to analyse (tasks are in priority order)
+		   task_vector: vector of tasks 
+		   direct_blocking: vector of direct blocking faced by task (is populated on the return)
+   Returns: response times of the first index tasks */
+std::vector<double> calculate_hp_resp_time_jdc(unsigned int index, const std::vector<Task> &task_vector, std::vector<double> &direct_blocking);
+
 #endif
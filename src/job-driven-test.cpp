@@ -134,9 +134,9 @@ double calculate_interference_jd(unsigned int index, const std::vector<Task> &ta
 			continue;
 
 		if (task_vector[i].getTotalGe() != 0)
-			interference = interference + ceil((resp_time + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
+			interference = interference + ceil((resp_time + task_vector[i].getJ() + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
 		else
-			interference = interference + ceil((resp_time)/task_vector[i].getT())*(task_vector[i].getC());
+			interference = interference + ceil((resp_time + task_vector[i].getJ())/task_vector[i].getT())*(task_vector[i].getC());
 	}
 	return interference;
 }
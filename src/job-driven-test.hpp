@@ -39,4 +39,10 @@
    Returns: 0 if schedulable */
 int check_schedulability_job_driven(std::vector<Task> &task_vector, std::vector<double> &resp_time);
 
+/**************** The Calculate High-Priority response time sub-routine using the job-driven approach ********************/ 
+/* Params: index: number of highest-priority tasks to analyse (tasks are in priority order)
+		   task_vector: vector of tasks 
+   Returns: response times of the first index tasks */
+std::vector<double> calculate_hp_resp_time_jd(unsigned int index, const std::vector<Task> &task_vector);
+
 #endif
@@ -27,6 +27,9 @@
 /* Standard Library Imports */
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -34,12 +37,19 @@
 #include <cstdlib>
 #include <ctime>
 #include <chrono>
+#include <thread>
+#include <atomic>
 
 /* Internal Headers */
 #include "task.hpp"
 #include "taskset.hpp"
 #include "taskset-gen.hpp"
 #include "task_partitioning.hpp"
+#include "sched-cache.hpp"
+#include "sched-config.hpp"
+#include "bounded-queue.hpp"
+#include "taskset-corpus.hpp"
+#include "result-log.hpp"
 #include "config.hpp"
 
 // Comparator class for ordering tasks using RMS
@@ -50,65 +60,817 @@ struct CompareTaskPriorityRMS {
     }
 } ComparePriorityRMS;
 
+// Order of the schedulability tests in the output file
+const sched_type csv_order[INVALID] = {REQUEST_DRIVEN, JOB_DRIVEN, HYBRID, REQUEST_DRIVEN_CONC, JOB_DRIVEN_CONC, 
+									   REQUEST_DRIVEN_CONC_SIMPLE, JOB_DRIVEN_CONC_RO, HYBRID_CONC, FIFO_CONC};
 
-int main(int argc, char **argv)
-{
+// Number of parallel local-search restarts to run when WFD fails (0 disables the improvement phase)
+int local_search_restarts = 0;
+
+// Split the tasks that fit on no single core across two cores when WFD fails (0 disables semi-partitioning)
+int semi_partitioning = 0;
+
+// Seed shared by the points of a sweep, taskset i of every point gets the same random draws (0 = fresh draws per point)
+unsigned int crn_seed = 0;
+
+// Record the per-task response times of the partitions (only needed by the result log)
+int record_response_times = 0;
+
+// Taskset generation parameters
+typedef struct generation_params {
+	int mode;						// 0 = CPU Util/GPU Util, 1 = Fraction of tasks with GPU segments, 2 = Number of gpu segments, 3 = max size (fraction) of GPU segment
+	int max_number_tasks;
+	double gpu_task_fraction;
+	int number_gpu_segments;
+	double utilization_bound;
+	double gpu_utilization_bound;
+	int harmonic_flag;
+	double max_gpu_fraction;
+} generation_params_t;
+
+// Taskset in the pipeline, with the index it was generated (or read from the corpus) under
+typedef struct pending_taskset {
+	int index;
 	std::vector<Task> task_vector;
-	double true_gpu_util, true_cpu_util;
+} pending_taskset_t;
+
+// Outcome of the analysis of one taskset
+typedef struct taskset_result {
+	int index;						// index of the taskset in generation (or corpus) order
+	int num_tasks;
+	int wfd_flag[INVALID];			// WFD (and improvement phases) verdict per test
+	int sa_flag[INVALID];			// SA-WFD verdict per test
+	int sa_gpu_cores[INVALID];		// cores hosting GPU-using tasks in the feasible SA-WFD partitions
+	int min_cores[INVALID];			// smallest platform admitting the taskset per test (-1 -> infeasible)
+	int local_search_recovered;		// partitions recovered by the local search
+	int semi_partitioned_recovered;	// partitions recovered by splitting tasks
+	unsigned long cache_hits;		// verdict cache counters of the analysis
+	unsigned long cache_misses;
+	unsigned long cache_evictions;
+	double cpu_util;
+	double gpu_util;
+	std::vector<double> wfd_resp_time[INVALID];	// per task, empty if WFD failed or not recorded
+	std::vector<double> sa_resp_time[INVALID];
+} taskset_result_t;
+
+// Counters aggregated over the tasksets
+typedef struct experiment_counters {
+	int wfd_counter[INVALID];
+	int sa_counter[INVALID];
+	int sa_gpu_cores[INVALID];
+	int sa_partitions[INVALID];
+	std::vector<std::vector<int>> min_core_histogram;	// per test, index 0 -> infeasible on num_cores
+	int local_search_recovered;
+	int semi_partitioned_recovered;
+	unsigned long cache_hits;
+	unsigned long cache_misses;
+	unsigned long cache_evictions;
+	double average_cpu_util;
+	double average_gpu_util;
+} experiment_counters_t;
+
+/**************** WFD followed by the optional semi-partitioning and local-search improvement phases ********************/ 
+/* Params: split_tasks: the split mapping if semi-partitioning recovered the taskset (task_vector then keeps the failed
+						WFD mapping), emptied otherwise
+		   others: see worst_fit_decreasing
+   Returns: 0 if a feasible partition exists */
+int worst_fit_decreasing_ls(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+							std::vector<double> &resp_time_rd,
+							std::vector<double> &resp_time_jd,
+							std::vector<std::vector<double>> &req_blocking_rd,
+							std::vector<double> &job_blocking_jd,
+							std::function<bool(Task const &, Task const &)> priority_ordering,
+							std::vector<Task> &split_tasks, taskset_result_t &result)
+{
+	int sched_flag = worst_fit_decreasing(task_vector, num_cores, sched_mode, resp_time_rd, resp_time_jd, 
+										  req_blocking_rd, job_blocking_jd, priority_ordering);
+
+	// Split tasks on a copy, the callers reuse the unsplit taskset
+	split_tasks.clear();
+	if (sched_flag != 0 && semi_partitioning)
+	{
+		split_tasks = task_vector;
+		sched_flag = semi_partitioned_worst_fit_decreasing(split_tasks, num_cores, sched_mode, resp_time_rd, resp_time_jd, 
+														   req_blocking_rd, job_blocking_jd, priority_ordering);
+		if (sched_flag == 0)
+			result.semi_partitioned_recovered++;
+		else
+			split_tasks.clear();
+	}
+
+	// Repair the partial WFD mapping
+	if (sched_flag != 0 && local_search_restarts > 0)
+	{
+		sched_flag = local_search_partitioning(task_vector, num_cores, sched_mode, resp_time_rd, resp_time_jd,
+											   req_blocking_rd, job_blocking_jd, priority_ordering,
+											   local_search_restarts, LS_MAX_ITERATIONS);
+		if (sched_flag == 0)
+			result.local_search_recovered++;
+	}
+	return sched_flag;
+}
+
+/**************** Generate a taskset in RMS order ********************/ 
+/* Params: arena, task_vector: reused across the calls of a thread, task_vector holds the taskset
+   Returns: 0 on success, -1 if the generation failed (try again) */
+int generate_taskset(const generation_params_t &gen_params, taskset_arena_t &arena, std::vector<Task> &task_vector)
+{
 	int number_tasks;
-	int retval;
 	int number_gpu_tasks;
+	int num_gpu_seg_random_flag; // flag to decide if number of gpu segments is set randomly or not;
+
+	// Chose parameters based on mode
+	switch (gen_params.mode)
+	{
+		case 0:
+			number_tasks = (taskset_rand() % gen_params.max_number_tasks) + 1;
+			number_gpu_tasks = ceil(gen_params.gpu_task_fraction*number_tasks); // Guarantees minimum fraction of tasks as specified
+			num_gpu_seg_random_flag = 1;
+			break;
+		
+		case 1:
+			number_tasks = gen_params.max_number_tasks;
+			number_gpu_tasks = floor(gen_params.gpu_task_fraction*number_tasks);
+			num_gpu_seg_random_flag = 1;
+			break;
+		
+		case 2:
+			number_tasks = gen_params.max_number_tasks;
+			number_gpu_tasks = floor(gen_params.gpu_task_fraction*number_tasks);
+			num_gpu_seg_random_flag = 0;
+			break;
+
+		case 3:
+			number_tasks = (taskset_rand() % gen_params.max_number_tasks) + 1;
+			number_gpu_tasks = ceil(gen_params.gpu_task_fraction*number_tasks); // Guarantees minimum fraction of tasks as specified
+			num_gpu_seg_random_flag = 1;
+			break;
+		
+		default:
+			task_vector.clear();
+			return -1;
+	}
+
+	if (DEBUG)
+		std::cout << "NumTasks = " << number_tasks << " NumAccTasks = " << number_gpu_tasks<< std::endl;
+	if (generate_tasks_in_place(arena, task_vector, number_tasks, number_gpu_tasks, gen_params.number_gpu_segments, 
+								gen_params.utilization_bound, gen_params.gpu_utilization_bound, gen_params.harmonic_flag, 
+								num_gpu_seg_random_flag, gen_params.max_gpu_fraction) != 0)
+		return -1;
+
+	// Sort Vector based on Some Priority ordering (here RMS)
+	std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+	return 0;
+}
+
+/**************** Generate a batch of tasksets ********************/ 
+/* Taskset k of the batch gets the draws generate_taskset makes for taskset first_index + k (the same common random numbers)
+   Params: gen_params: taskset generation parameters
+		   first_index: index of the first taskset of the batch
+		   num_tasksets: tasksets in the batch
+		   arena: generation arena of the calling thread (cleared, then holds the tasksets in generation order)
+   Returns: 0 on success, -1 if the parameters keep failing */
+int generate_taskset_block(const generation_params_t &gen_params, int first_index, int num_tasksets, taskset_arena_t &arena)
+{
+	int random_number_tasks;
+	int num_gpu_seg_random_flag;
+
+	// Chose parameters based on mode, as generate_taskset
+	switch (gen_params.mode)
+	{
+		case 0:
+		case 3:
+			random_number_tasks = 1;
+			num_gpu_seg_random_flag = 1;
+			break;
+
+		case 1:
+			random_number_tasks = 0;
+			num_gpu_seg_random_flag = 1;
+			break;
+
+		case 2:
+			random_number_tasks = 0;
+			num_gpu_seg_random_flag = 0;
+			break;
+
+		default:
+			return -1;
+	}
+
+	if (generate_taskset_batch(arena, num_tasksets, gen_params.max_number_tasks, random_number_tasks, gen_params.gpu_task_fraction,
+							   gen_params.number_gpu_segments, gen_params.utilization_bound, gen_params.gpu_utilization_bound,
+							   gen_params.harmonic_flag, num_gpu_seg_random_flag, gen_params.max_gpu_fraction, 
+							   crn_seed, first_index) != num_tasksets)
+		return -1;
+	return 0;
+}
+
+/**************** Response times of a split mapping, one per task of the unsplit taskset ********************/ 
+/* A split task completes with its tail, released when the head completes, so its response time is J + R of the tail;
+   it is reported at the position of its head
+   Params: split_tasks: split mapping, in priority order
+		   sched_mode: which schedulability test
+		   resp_time: response times (populated by this function)
+   Returns: 0 if the mapping is schedulable */
+int get_split_partition_response_times(std::vector<Task> &split_tasks, sched_type sched_mode, std::vector<double> &resp_time)
+{
+	std::vector<double> part_resp_time;
+
+	resp_time.clear();
+	if (get_partition_response_times(split_tasks, sched_mode, part_resp_time) != 0)
+		return -1;
+
+	for (unsigned int index = 0; index < split_tasks.size(); index++)
+	{
+		if (split_tasks[index].getSplitPart() == SPLIT_TAIL)
+			continue;
+
+		resp_time.push_back(part_resp_time[index]);
+		if (split_tasks[index].getSplitPart() != SPLIT_HEAD)
+			continue;
+		for (unsigned int i = 0; i < split_tasks.size(); i++)
+		{
+			if (split_tasks[i].getSplitPart() == SPLIT_TAIL && split_tasks[i].getSplitID() == split_tasks[index].getSplitID())
+				resp_time.back() = split_tasks[i].getJ() + part_resp_time[i];
+		}
+	}
+	return 0;
+}
+
+/**************** Analyse a taskset with every test, under WFD and SA-WFD (or the minimum core count search) ********************/ 
+void analyse_taskset(std::vector<Task> &task_vector, int num_cores, int min_core_flag, taskset_result_t &result)
+{
+	std::vector<Task> min_core_tasks;
+	std::vector<Task> split_tasks;
+	int resp_time_flag;
+
+	// Request-Driven Vectors
+	std::vector<double> resp_time_rd;
+	std::vector<std::vector<double>> req_blocking_rd;
+
+	// Job-Driven Vectors
+	std::vector<double> resp_time_jd;
+	std::vector<double> job_blocking_jd;
+
+	// Cached verdicts are only reused within the analysis of one taskset, in the thread's own cache
+	unsigned long cache_hits, cache_misses, cache_evictions;
+	sched_cache_clear();
+	sched_cache_get_stats(cache_hits, cache_misses, cache_evictions);
+
+	result.num_tasks = task_vector.size();
+	result.local_search_recovered = 0;
+	result.semi_partitioned_recovered = 0;
+	for (int test = 0; test < INVALID; test++)
+	{
+		result.wfd_flag[test] = -1;
+		result.sa_flag[test] = -1;
+		result.sa_gpu_cores[test] = 0;
+		result.min_cores[test] = -1;
+		result.wfd_resp_time[test].clear();
+		result.sa_resp_time[test].clear();
+	}
+
+	if (DEBUG)
+		print_taskset(task_vector);
+
+	// Find the smallest platform on which each test admits the taskset
+	if (min_core_flag)
+	{
+		for (int test = 0; test < INVALID; test++)
+		{
+			min_core_tasks = task_vector;
+			result.min_cores[test] = find_min_cores_wfd(min_core_tasks, num_cores, (sched_type) test, resp_time_rd, resp_time_jd, 
+														req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
+		}
+	}
+	else
+	{
+		// Check Schedulability -> Using WFD as task partitioning
+		for (int test = 0; test < INVALID; test++)
+		{
+			resp_time_rd.clear();
+			req_blocking_rd.clear();
+			resp_time_jd.clear();
+			job_blocking_jd.clear();
+			result.wfd_flag[test] = worst_fit_decreasing_ls(task_vector, num_cores, (sched_type) test, resp_time_rd, resp_time_jd, 
+															req_blocking_rd, job_blocking_jd, ComparePriorityRMS, split_tasks, result);
+
+			// Record the partition that passed, a partition recovered by splitting tasks is not the one left in task_vector
+			if (record_response_times && result.wfd_flag[test] == 0)
+			{
+				if (split_tasks.empty())
+					resp_time_flag = get_partition_response_times(task_vector, (sched_type) test, result.wfd_resp_time[test]);
+				else
+					resp_time_flag = get_split_partition_response_times(split_tasks, (sched_type) test, result.wfd_resp_time[test]);
+				if (resp_time_flag != 0)
+					result.wfd_resp_time[test].clear();
+			}
+		}
+
+		// Check Schedulability -> Using SyncAware WFD as task partitioning
+		for (int test = 0; test < INVALID; test++)
+		{
+			resp_time_rd.clear();
+			req_blocking_rd.clear();
+			resp_time_jd.clear();
+			job_blocking_jd.clear();
+			result.sa_flag[test] = sync_aware_worst_fit_decreasing(task_vector, num_cores, (sched_type) test, resp_time_rd, resp_time_jd, 
+																   req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
+			if (result.sa_flag[test] == 0)
+				result.sa_gpu_cores[test] = get_num_gpu_cores(task_vector);
+
+			if (record_response_times && result.sa_flag[test] == 0 &&
+				get_partition_response_times(task_vector, (sched_type) test, result.sa_resp_time[test]) != 0)
+				result.sa_resp_time[test].clear();
+		}
+
+		if (DEBUG)
+		{
+			std::cout << "Schedulability WFD / SA-WFD:" << "\n";
+			for (int test = 0; test < INVALID; test++)
+				std::cout << get_sched_type_label(test) << ": " << result.wfd_flag[test] << " / " << result.sa_flag[test] << "\n";
+		}
+	}
+
+	// Compute utilization values for energy calculations
+	result.cpu_util = get_taskset_cpu_util(task_vector);
+	result.gpu_util = get_taskset_gpu_util(task_vector);
+
+	sched_cache_get_stats(result.cache_hits, result.cache_misses, result.cache_evictions);
+	result.cache_hits -= cache_hits;
+	result.cache_misses -= cache_misses;
+	result.cache_evictions -= cache_evictions;
+}
+
+/**************** Obtain the taskset to analyse ********************/ 
+/* Generates a taskset or reads it from a corpus, generated tasksets are recorded in the corpus if one is written
+   Params: gen_params: taskset generation parameters
+		   corpus_reader: corpus to read from (NULL = generate)
+		   corpus_writer: corpus to record into (NULL = none)
+		   index: index of the taskset in the corpus
+		   arena: generation arena of the calling thread
+		   task_vector: RMS-sorted taskset (populated by this function, its storage is reused)
+   Returns: 0 on success, -1 if the generator has to retry */
+int obtain_taskset(const generation_params_t &gen_params, const CorpusReader *corpus_reader,
+				   CorpusWriter *corpus_writer, int index, taskset_arena_t &arena, std::vector<Task> &task_vector)
+{
+	// Corpus tasksets were recorded in priority order
+	if (corpus_reader != NULL)
+	{
+		if (corpus_reader->materialize(index, task_vector) != 0)
+		{
+			std::cout << "Corrupt taskset " << index << " in corpus, Exiting ..\n";
+			exit(1);
+		}
+		return 0;
+	}
+
+	if (generate_taskset(gen_params, arena, task_vector) != 0)
+		return -1;
+	// Recorded as entry index, the pipeline generators finish out of order
+	if (corpus_writer != NULL)
+		corpus_writer->addTaskset(index, task_vector);
+	return 0;
+}
+
+/**************** Take a taskset of a generated batch in RMS order ********************/ 
+/* Params: arena: batch of the calling thread (see generate_taskset_block)
+		   batch_index: taskset within the batch
+		   index: index of the taskset in generation order
+		   corpus_writer: corpus to record into (NULL = none)
+		   task_vector: RMS-sorted taskset (populated by this function, its storage is reused) */
+void take_batch_taskset(const taskset_arena_t &arena, int batch_index, int index, CorpusWriter *corpus_writer, 
+						std::vector<Task> &task_vector)
+{
+	materialize_taskset(arena, batch_index, task_vector);
+	std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+	if (corpus_writer != NULL)
+		corpus_writer->addTaskset(index, task_vector);
+}
+
+/**************** Add the outcome of a taskset to the counters ********************/ 
+void reduce_taskset_result(const taskset_result_t &result, experiment_counters_t &counters)
+{
+	for (int test = 0; test < INVALID; test++)
+	{
+		// Update the schedulability counters
+		if (result.wfd_flag[test] == 0)
+			counters.wfd_counter[test]++;
+
+		if (result.sa_flag[test] == 0)
+		{
+			counters.sa_counter[test]++;
+			counters.sa_gpu_cores[test] += result.sa_gpu_cores[test];
+			counters.sa_partitions[test]++;
+		}
+
+		if (result.min_cores[test] > 0)
+			counters.min_core_histogram[test][result.min_cores[test]]++;
+		else
+			counters.min_core_histogram[test][0]++;
+	}
+	counters.local_search_recovered += result.local_search_recovered;
+	counters.semi_partitioned_recovered += result.semi_partitioned_recovered;
+	counters.cache_hits += result.cache_hits;
+	counters.cache_misses += result.cache_misses;
+	counters.cache_evictions += result.cache_evictions;
+
+	// Update average utilization values
+	counters.average_gpu_util = counters.average_gpu_util + result.gpu_util;
+	counters.average_cpu_util = counters.average_cpu_util + result.cpu_util;
+}
+
+/**************** Buffer the outcome of a taskset in the result log ********************/ 
+void log_taskset_result(const generation_params_t &gen_params, int num_cores, int min_core_flag, 
+						const taskset_result_t &result, ResultLog &result_log)
+{
+	result_record_t record;
+
+	record.taskset_index = result.index;
+	record.mode = gen_params.mode;
+	record.harmonic_flag = gen_params.harmonic_flag;
+	record.max_number_tasks = gen_params.max_number_tasks;
+	record.number_gpu_segments = gen_params.number_gpu_segments;
+	record.num_cores = num_cores;
+	record.gpu_task_fraction = gen_params.gpu_task_fraction;
+	record.utilization_bound = gen_params.utilization_bound;
+	record.gpu_utilization_bound = gen_params.gpu_utilization_bound;
+	record.max_gpu_fraction = gen_params.max_gpu_fraction;
+	record.cpu_util = result.cpu_util;
+	record.gpu_util = result.gpu_util;
+	record.num_tasks = result.num_tasks;
+
+	// The minimum core count search runs neither partitioning on num_cores
+	for (int test = 0; test < INVALID; test++)
+	{
+		if (min_core_flag)
+		{
+			record.wfd_verdict[test] = VERDICT_NOT_RUN;
+			record.sa_verdict[test] = VERDICT_NOT_RUN;
+		}
+		else
+		{
+			record.wfd_verdict[test] = result.wfd_flag[test] == 0 ? VERDICT_ADMITTED : VERDICT_REJECTED;
+			record.sa_verdict[test] = result.sa_flag[test] == 0 ? VERDICT_ADMITTED : VERDICT_REJECTED;
+		}
+		record.wfd_resp_time[test] = result.wfd_resp_time[test];
+		record.sa_resp_time[test] = result.sa_resp_time[test];
+	}
+	result_log.append(record);
+}
+
+/**************** Width of the Wilson score interval of a proportion ********************/ 
+/* Params: successes: tasksets admitted
+		   trials   : tasksets analysed
+   Returns: width of the CI_CONFIDENCE_Z interval, 1 without trials */
+double wilson_interval_width(long successes, long trials)
+{
+	double z = CI_CONFIDENCE_Z;
+	double n = trials;
+	double p;
+
+	if (trials <= 0)
+		return 1;
+	p = successes/n;
+	return 2*z/(1 + z*z/n)*sqrt(p*(1 - p)/n + z*z/(4*n*n));
+}
+
+/**************** Check whether the schedulable fraction of every test is known precisely enough ********************/ 
+/* Params: counters       : counters aggregated so far
+		   trials         : tasksets analysed so far
+		   min_core_flag  : the proportion is feasibility on the largest platform (minimum core count search)
+		   target_width   : largest interval width accepted
+		   max_width      : widest interval over the tests, under WFD and SA-WFD (populated by this function)
+   Returns: true if every interval is narrower than target_width */
+bool sample_converged(const experiment_counters_t &counters, int trials, int min_core_flag, double target_width, 
+					  double &max_width)
+{
+	max_width = 0;
+	for (int test = 0; test < INVALID; test++)
+	{
+		if (min_core_flag)
+			max_width = std::max(max_width, wilson_interval_width(trials - counters.min_core_histogram[test][0], trials));
+		else
+		{
+			max_width = std::max(max_width, wilson_interval_width(counters.wfd_counter[test], trials));
+			max_width = std::max(max_width, wilson_interval_width(counters.sa_counter[test], trials));
+		}
+	}
+	return max_width < target_width;
+}
+
+/**************** Save the progress of a run ********************/ 
+/* The state is written to a temporary file renamed over the checkpoint, a run killed while saving keeps the previous one
+   Params: filename: checkpoint file
+		   run_args: positional arguments of the run, a resumed run must use the same ones
+		   taskset_counter: tasksets analysed so far
+		   counters: counters aggregated so far
+   Returns: 0 on success */
+int save_checkpoint(const std::string &filename, const std::string &run_args, int taskset_counter, 
+					const experiment_counters_t &counters)
+{
+	std::string engine_state;
+	std::string temp_filename = filename + ".tmp";
+
+	if (get_taskset_generator_state(engine_state) != 0)
+		return -1;
+
+	std::ofstream outfile(temp_filename, std::ios_base::trunc);
+	outfile << std::setprecision(17);
+	outfile << "version " << CHECKPOINT_VERSION << "\n";
+	outfile << "args " << run_args << "\n";
+	outfile << "tasksets " << taskset_counter << "\n";
+	outfile << "engine " << engine_state << "\n";
+	outfile << "counters";
+	for (int test = 0; test < INVALID; test++)
+		outfile << " " << counters.wfd_counter[test] << " " << counters.sa_counter[test] << " " 
+				<< counters.sa_gpu_cores[test] << " " << counters.sa_partitions[test];
+	outfile << "\n";
+	outfile << "histogram " << counters.min_core_histogram[0].size();
+	for (int test = 0; test < INVALID; test++)
+		for (unsigned int cores = 0; cores < counters.min_core_histogram[test].size(); cores++)
+			outfile << " " << counters.min_core_histogram[test][cores];
+	outfile << "\n";
+	outfile << "recovered " << counters.local_search_recovered << " " << counters.semi_partitioned_recovered << "\n";
+	outfile << "utilization " << counters.average_cpu_util << " " << counters.average_gpu_util << "\n";
+	outfile.close();
+	if (!outfile)
+		return -1;
+
+	return std::rename(temp_filename.c_str(), filename.c_str());
+}
+
+/**************** Restore the progress of a run ********************/ 
+/* Params: see save_checkpoint (taskset_counter and counters are populated by this function, they have to be sized already)
+   Returns: 0 on success, -1 if the checkpoint is malformed or belongs to another run */
+int load_checkpoint(const std::string &filename, const std::string &run_args, int &taskset_counter, 
+					experiment_counters_t &counters)
+{
+	std::ifstream infile(filename);
+	std::string line, key, value;
+	unsigned int version, histogram_size;
+
+	if (!infile)
+		return -1;
+
+	// Version and arguments
+	if (!std::getline(infile, line) || std::sscanf(line.c_str(), "version %u", &version) != 1 || version != CHECKPOINT_VERSION)
+		return -1;
+	if (!std::getline(infile, line) || line != "args " + run_args)
+		return -1;
+
+	// Progress and random stream
+	if (!(infile >> key >> taskset_counter) || key != "tasksets")
+		return -1;
+	infile >> key;
+	std::getline(infile, value);
+	if (key != "engine" || set_taskset_generator_state(value) != 0)
+		return -1;
+
+	// Counters
+	if (!(infile >> key) || key != "counters")
+		return -1;
+	for (int test = 0; test < INVALID; test++)
+		infile >> counters.wfd_counter[test] >> counters.sa_counter[test] >> counters.sa_gpu_cores[test] >> counters.sa_partitions[test];
+	if (!(infile >> key >> histogram_size) || key != "histogram" || histogram_size != counters.min_core_histogram[0].size())
+		return -1;
+	for (int test = 0; test < INVALID; test++)
+		for (unsigned int cores = 0; cores < histogram_size; cores++)
+			infile >> counters.min_core_histogram[test][cores];
+	if (!(infile >> key >> counters.local_search_recovered >> counters.semi_partitioned_recovered) || key != "recovered")
+		return -1;
+	if (!(infile >> key >> counters.average_cpu_util >> counters.average_gpu_util) || key != "utilization")
+		return -1;
+	return 0;
+}
+
+/**************** Run the experiment as a generate -> analyse -> reduce pipeline ********************/ 
+/* Generator threads claim PIPELINE_GENERATION_BATCH tasksets at a time, generate them into their arena with
+   generate_taskset_block and fill a bounded lock-free ring with them RMS-sorted, analysis workers drain it into a
+   second ring of results and the calling thread reduces them; a stage facing a full or empty ring yields
+   Params: gen_params: taskset generation parameters
+		   taskset_count: number of tasksets to analyse
+		   num_cores, min_core_flag: see analyse_taskset
+		   num_workers: number of analysis workers
+		   corpus_reader, corpus_writer: see obtain_taskset
+		   result_log: per-taskset result log (NULL = none), only the reducer appends to it
+		   counters: counters to aggregate into */
+void run_pipeline(const generation_params_t &gen_params, int taskset_count, int num_cores, int min_core_flag, 
+				  int num_workers, const CorpusReader *corpus_reader, CorpusWriter *corpus_writer,
+				  ResultLog *result_log, experiment_counters_t &counters)
+{
+	int num_generators = PIPELINE_GENERATORS;
+	BoundedQueue<pending_taskset_t> taskset_queue(PIPELINE_QUEUE_DEPTH);
+	BoundedQueue<taskset_result_t> result_queue(PIPELINE_QUEUE_DEPTH);
+	std::atomic<int> generation_claims(0);
+	std::atomic<int> analysis_claims(0);
+	std::atomic<long> generator_stalls(0);	// ring of tasksets full
+	std::atomic<long> worker_stalls(0);		// ring of tasksets empty or ring of results full
+	std::vector<double> generator_busy(num_generators, 0.0);
+	std::vector<double> worker_busy(num_workers, 0.0);
+	std::vector<std::thread> threads;
+	double reducer_busy = 0;
+	double depth_sum = 0;
+	size_t depth_max = 0;
+	unsigned int base_seed = rand();
+	taskset_result_t result;
+
+	auto pipeline_start = std::chrono::steady_clock::now();
+
+	// Generators -> each with its own engine
+	for (int g = 0; g < num_generators; g++)
+	{
+		threads.emplace_back([&, g]()
+		{
+			pending_taskset_t pending;
+			taskset_arena_t arena;
+			int first_index, num_tasksets;
+			seed_taskset_generator(base_seed + g);
+			while ((first_index = generation_claims.fetch_add(PIPELINE_GENERATION_BATCH)) < taskset_count)
+			{
+				num_tasksets = std::min(PIPELINE_GENERATION_BATCH, taskset_count - first_index);
+
+				auto start = std::chrono::steady_clock::now();
+				if (corpus_reader == NULL && generate_taskset_block(gen_params, first_index, num_tasksets, arena) != 0)
+				{
+					std::cout << "Cannot generate tasksets " << first_index << " .. " << first_index + num_tasksets - 1 
+							  << " with these parameters, Exiting ..\n";
+					exit(1);
+				}
+				generator_busy[g] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+				for (int k = 0; k < num_tasksets; k++)
+				{
+					pending.index = first_index + k;
+					start = std::chrono::steady_clock::now();
+					if (corpus_reader != NULL)
+						obtain_taskset(gen_params, corpus_reader, NULL, pending.index, arena, pending.task_vector);
+					else
+						take_batch_taskset(arena, k, pending.index, corpus_writer, pending.task_vector);
+					generator_busy[g] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+					while (!taskset_queue.tryPush(pending))
+					{
+						generator_stalls++;
+						std::this_thread::yield();
+					}
+				}
+			}
+		});
+	}
+
+	// Analysis workers -> every claimed taskset is eventually produced
+	for (int w = 0; w < num_workers; w++)
+	{
+		threads.emplace_back([&, w]()
+		{
+			pending_taskset_t pending;
+			taskset_result_t worker_result;
+			while (analysis_claims.fetch_add(1) < taskset_count)
+			{
+				while (!taskset_queue.tryPop(pending))
+				{
+					worker_stalls++;
+					std::this_thread::yield();
+				}
+
+				auto start = std::chrono::steady_clock::now();
+				analyse_taskset(pending.task_vector, num_cores, min_core_flag, worker_result);
+				worker_result.index = pending.index;
+				worker_busy[w] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+				while (!result_queue.tryPush(worker_result))
+				{
+					worker_stalls++;
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	// Reducer -> this thread, sampling the depth of the ring of tasksets
+	for (int reduced = 0; reduced < taskset_count; )
+	{
+		if (!result_queue.tryPop(result))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		auto start = std::chrono::steady_clock::now();
+		reduce_taskset_result(result, counters);
+		if (result_log != NULL)
+			log_taskset_result(gen_params, num_cores, min_core_flag, result, *result_log);
+		reducer_busy += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		reduced++;
+
+		depth_sum += taskset_queue.size();
+		depth_max = std::max(depth_max, taskset_queue.size());
+	}
+
+	for (unsigned int index = 0; index < threads.size(); index++)
+		threads[index].join();
+
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - pipeline_start).count();
+
+	// Report the stage throughputs -> tasksets per second of busy time, over all the threads of the stage
+	double generator_time = 0, worker_time = 0;
+	for (int g = 0; g < num_generators; g++)
+		generator_time += generator_busy[g];
+	for (int w = 0; w < num_workers; w++)
+		worker_time += worker_busy[w];
+
+	std::cout << "Pipeline Generators/Workers: " << num_generators << "/" << num_workers << "\n";
+	std::cout << "Pipeline Queue Depth Avg/Max/Capacity: " << depth_sum/taskset_count << "/" << depth_max << "/" << taskset_queue.capacity() << "\n";
+	std::cout << "Pipeline Stalls Generate/Analyse: " << generator_stalls << "/" << worker_stalls << "\n";
+	std::cout << "Pipeline Throughput (tasksets/s) Generate/Analyse/Reduce/Overall: " 
+			  << num_generators*taskset_count/generator_time << "/" << num_workers*taskset_count/worker_time << "/"
+			  << taskset_count/reducer_busy << "/" << taskset_count/elapsed << "\n";
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<Task> task_vector;
+	taskset_arena_t arena;
+	taskset_result_t result;
 	int taskset_counter = 0;
 
-	// Schedulability Flags
-	int sched_flag_rd = 0;
-	int sched_flag_jd = 0;
-	int sched_flag_hybrid = 0;
-	int sched_flag_rd_conc = 0;
-	int sched_flag_rd_conc_simple = 0;
-	int sched_flag_jd_conc = 0;
-	int sched_flag_jd_conc_ro = 0;
-	int sched_flag_hybrid_conc = 0;
-	int sched_flag_fifo_conc = 0;
-
-	// Schedulability Counters -> WFD
-	int counter_rd = 0;
-	int counter_jd = 0;
-	int counter_hybrid = 0;
-	int counter_rd_conc = 0;
-	int counter_rd_conc_simple = 0;
-	int counter_jd_conc = 0;
-	int counter_jd_conc_ro = 0;
-	int counter_hybrid_conc = 0;
-	int counter_fifo_conc = 0;
-
-	// Schedulability Counters -> SA-WFD
-	int sa_counter_rd = 0;
-	int sa_counter_jd = 0;
-	int sa_counter_hybrid = 0;
-	int sa_counter_rd_conc = 0;
-	int sa_counter_rd_conc_simple = 0;
-	int sa_counter_jd_conc = 0;
-	int sa_counter_jd_conc_ro = 0;
-	int sa_counter_hybrid_conc = 0;
-	int sa_counter_fifo_conc = 0;
-
-	// Average Util counters
-	double average_cpu_util = 0, average_gpu_util = 0;
+	// Checkpoint options (--checkpoint <file>, --resume), sequential sampling (--ci-width <width>, the taskset count
+	// becomes an upper bound), common random numbers (--crn-seed <seed>), the hyperperiod cap of divisor-rich
+	// periods (--hyperperiod-cap <cap>) and the runtime configuration (--config <key>=<value>, --config-file <file>),
+	// the positional arguments follow without them; --dump-log <file> and --dump-disagreements <file> print a result
+	// log (argv[19] of an earlier run) as CSV instead of running, e.g. ./mcprocessor_exp.out --dump-disagreements run.log
+	std::string checkpoint_filename;
+	std::string run_args;
+	int resume_flag = 0;
+	double ci_width = 0;
+	std::vector<char *> positional_args;
+	for (int index = 0; index < argc; index++)
+	{
+		std::string arg(argv[index]);
+		if (arg == "--resume")
+			resume_flag = 1;
+		else if (arg == "--checkpoint" && index + 1 < argc)
+			checkpoint_filename = argv[++index];
+		else if (arg == "--ci-width" && index + 1 < argc)
+		{
+			ci_width = std::atof(argv[++index]);
+			run_args += (run_args.empty() ? "" : " ") + arg + " " + argv[index];
+		}
+		else if (arg == "--crn-seed" && index + 1 < argc)
+		{
+			crn_seed = std::strtoul(argv[++index], NULL, 10);
+			run_args += (run_args.empty() ? "" : " ") + arg + " " + argv[index];
+		}
+		else if (arg == "--hyperperiod-cap" && index + 1 < argc)
+		{
+			if (set_hyperperiod_cap(std::strtoull(argv[++index], NULL, 10)) == 0)
+			{
+				std::cout << "No period fits under the hyperperiod cap, Exiting ..\n";
+				exit(1);
+			}
+			run_args += (run_args.empty() ? "" : " ") + arg + " " + argv[index];
+		}
+		else if ((arg == "--dump-log" || arg == "--dump-disagreements") && index + 1 < argc)
+			exit(result_log_dump(argv[index + 1], arg == "--dump-disagreements", std::cout) == 0 ? 0 : 1);
+		else if (arg == "--config" && index + 1 < argc)
+		{
+			if (apply_sched_config(argv[++index]) != 0)
+				exit(1);
+			run_args += (run_args.empty() ? "" : " ") + arg + " " + argv[index];
+		}
+		else if (arg == "--config-file" && index + 1 < argc)
+		{
+			if (apply_sched_config_file(argv[++index]) != 0)
+				exit(1);
+			run_args += (run_args.empty() ? "" : " ") + arg + " " + argv[index];
+		}
+		else
+		{
+			positional_args.push_back(argv[index]);
+			if (index > 0)
+				run_args += (run_args.empty() ? "" : " ") + arg;
+		}
+	}
+	argc = positional_args.size();
+	argv = positional_args.data();
 
 	// Output Filestream
 	std::ofstream outfile;
 	int file_flag = 0;
 
+	// Taskset generation parameters
+	generation_params_t gen_params;
+
 	// Number of tasksets to simulate
 	int taskset_count = 1;
 	if (argc > 1)
 		taskset_count = std::atoi(argv[1]);
 
-	// Generate only harmonic tasksets
-	int harmonic_flag = 0;
+	// Generate only harmonic tasksets (2: divisor-rich periods with a bounded hyperperiod)
+	gen_params.harmonic_flag = 0;
 	if (argc > 2)
-		harmonic_flag = std::atoi(argv[2]);
+		gen_params.harmonic_flag = std::atoi(argv[2]);
 
 	// Output filename
 	if (argc > 3)
@@ -124,51 +886,55 @@ int main(int argc, char **argv)
 		epsilon = std::atof(argv[4]);
 
 	// CPU Utilization Bound
-	double utilization_bound = 0.5;
+	gen_params.utilization_bound = 0.5;
 	if (argc > 5)
-		utilization_bound = std::atof(argv[5]);
+		gen_params.utilization_bound = std::atof(argv[5]);
 
 	// GPU utilization bound
-	double gpu_utilization_bound = 0.3;
+	gen_params.gpu_utilization_bound = 0.3;
 	if (argc > 6)
-		gpu_utilization_bound = std::atof(argv[6]);
+		gen_params.gpu_utilization_bound = std::atof(argv[6]);
 
 	// Fraction of tasks with GPU segments
-	double gpu_task_fraction = FRACTION_TASKS_GPU;
+	gen_params.gpu_task_fraction = FRACTION_TASKS_GPU;
 	if (argc > 7)
 	{
-		gpu_task_fraction = std::atof(argv[7]);
+		gen_params.gpu_task_fraction = std::atof(argv[7]);
 	}
 
 	// Max Number of GPU segments
-	int number_gpu_segments = MAX_GPU_SEGMENTS;
+	gen_params.number_gpu_segments = MAX_GPU_SEGMENTS;
 	if (argc > 8)
 	{
-		number_gpu_segments = std::atoi(argv[8]);
+		gen_params.number_gpu_segments = std::atoi(argv[8]);
 	}
 
 	// Max number of tasks
-	int max_number_tasks = MAX_TASKS;
+	gen_params.max_number_tasks = MAX_TASKS;
 	if (argc > 9)
 	{
-		max_number_tasks = std::atoi(argv[9]);
+		gen_params.max_number_tasks = std::atoi(argv[9]);
 	}
 
 	// Maximum GPU fraction
-	double max_gpu_fraction = MAX_GPU_FRACTION;
+	gen_params.max_gpu_fraction = MAX_GPU_FRACTION;
 	if (argc > 10)
 	{
-		max_gpu_fraction = std::atof(argv[10]);
+		gen_params.max_gpu_fraction = std::atof(argv[10]);
 	}
 
 	// Modes (Sweep holding others constant)
 	/* 0 = CPU Util/GPU Util, 1 = Fraction of tasks with GPU segments, 2 = Number of gpu segments, 3 = max size (fraction) of GPU segment*/
-	int mode = 0; 
-	int num_gpu_seg_random_flag; // flag to decide if number of gpu segments is set randomly or not;
+	gen_params.mode = 0; 
 	if (argc > 11)
 	{
-		mode = std::atoi(argv[11]);;
-		std::cout << "Mode = " << mode << "\n";
+		gen_params.mode = std::atoi(argv[11]);;
+		std::cout << "Mode = " << gen_params.mode << "\n";
+	}
+	if (gen_params.mode < 0 || gen_params.mode > 3)
+	{
+		std::cout << "Invalid mode chosen, Exiting ..\n";
+		exit(1);
 	}
 
 	// Number of Cores
@@ -178,294 +944,282 @@ int main(int argc, char **argv)
 		num_cores = std::atoi(argv[12]);
 	}
 
-	// Request-Driven Vectors
-	std::vector<double> resp_time_rd;
-	std::vector<std::vector<double>> req_blocking_rd;
+	// Number of local-search restarts if WFD fails (0 = disabled)
+	if (argc > 13)
+	{
+		local_search_restarts = std::atoi(argv[13]);
+	}
 
-	// Job-Driven Vectors
-	std::vector<double> resp_time_jd;
-	std::vector<double> job_blocking_jd;
+	// Minimum core count search (the number of cores above is the largest platform considered)
+	int min_core_flag = 0;
+	if (argc > 14)
+	{
+		min_core_flag = std::atoi(argv[14]);
+	}
 
-	/* initialize random seed: */
-  	srand (time(NULL));
+	// Semi-partitioned WFD (split the tasks WFD cannot place)
+	if (argc > 15)
+	{
+		semi_partitioning = std::atoi(argv[15]);
+	}
 
-	while (taskset_counter < taskset_count)
+	// Number of analysis workers of the generation/analysis pipeline (0 = generate and analyse in sequence)
+	int pipeline_workers = 0;
+	if (argc > 16)
 	{
-		// Chose parameters based on mode
-		/* 0 = CPU Util/GPU Util, 1 = Fraction of tasks with GPU segments, 2 = Number of gpu segments, 3 = max size (fraction) of GPU segment*/
-		switch (mode)
-		{
-			case 0:
-				number_tasks = (rand() % max_number_tasks) + 1;
-				number_gpu_tasks = ceil(gpu_task_fraction*number_tasks); // Guarantees minimum fraction of tasks as specified
-				num_gpu_seg_random_flag = 1;
-				break;
-			
-			case 1:
-				number_tasks = max_number_tasks;
-				number_gpu_tasks = floor(gpu_task_fraction*number_tasks);
-				num_gpu_seg_random_flag = 1;
-				break;
-			
-			case 2:
-				number_tasks = max_number_tasks;
-				number_gpu_tasks = floor(gpu_task_fraction*number_tasks);
-				num_gpu_seg_random_flag = 0;
-				break;
-
-			case 3:
-				number_tasks = (rand() % max_number_tasks) + 1;
-				number_gpu_tasks = ceil(gpu_task_fraction*number_tasks); // Guarantees minimum fraction of tasks as specified
-				num_gpu_seg_random_flag = 1;
-				break;
-			
-			default:
-				std::cout << "Invalid mode chosen, Exiting ..\n";
-				exit(1);
-		}
+		pipeline_workers = std::atoi(argv[16]);
+	}
 
-		if (DEBUG)
-			std::cout << "Taskset " << taskset_counter << " NumTasks = " << number_tasks << " NumAccTasks = " << number_gpu_tasks<< std::endl;
-		task_vector = generate_tasks(number_tasks, number_gpu_tasks, number_gpu_segments, utilization_bound, gpu_utilization_bound, 
-									 harmonic_flag, num_gpu_seg_random_flag, max_gpu_fraction);
+	// Taskset corpus (1 = record the generated tasksets, 2 = analyse the tasksets of the corpus)
+	std::string corpus_filename;
+	int corpus_mode = CORPUS_NONE;
+	if (argc > 18)
+	{
+		corpus_filename = argv[17];
+		corpus_mode = std::atoi(argv[18]);
+	}
+	if (corpus_mode < CORPUS_NONE || corpus_mode > CORPUS_READ)
+	{
+		std::cout << "Invalid corpus mode chosen, Exiting ..\n";
+		exit(1);
+	}
 
-		// If Task Vector is empty the try again
-		if (task_vector.empty())
-			continue;
+	CorpusReader corpus_reader;
+	CorpusWriter corpus_writer;
+	if (corpus_mode == CORPUS_READ)
+	{
+		if (corpus_reader.open(corpus_filename) != 0)
+			exit(1);
+		if ((unsigned long) taskset_count > corpus_reader.getNumTasksets())
+			taskset_count = corpus_reader.getNumTasksets();
+		std::cout << "Corpus Tasksets: " << corpus_reader.getNumTasksets() << "\n";
+	}
+	else if (corpus_mode == CORPUS_WRITE)
+		corpus_writer.open(corpus_filename);
 
-		// Sort Vector based on Some Priority ordering (here RMS)
-		std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+	// Per-taskset result log
+	ResultLog result_log;
+	int result_log_flag = 0;
+	if (argc > 19)
+	{
+		if (result_log.open(argv[19]) != 0)
+			exit(1);
+		result_log_flag = 1;
+		record_response_times = 1;
+	}
 
-		if (DEBUG)
-			print_taskset(task_vector);
+	// Counters
+	experiment_counters_t counters;
+	for (int test = 0; test < INVALID; test++)
+	{
+		counters.wfd_counter[test] = 0;
+		counters.sa_counter[test] = 0;
+		counters.sa_gpu_cores[test] = 0;
+		counters.sa_partitions[test] = 0;
+	}
+	counters.min_core_histogram.assign(INVALID, std::vector<int>(num_cores + 1, 0));
+	counters.local_search_recovered = 0;
+	counters.semi_partitioned_recovered = 0;
+	counters.cache_hits = 0;
+	counters.cache_misses = 0;
+	counters.cache_evictions = 0;
+	counters.average_cpu_util = 0;
+	counters.average_gpu_util = 0;
 
-		// Check Schedulability -> Using WFD as task partitioning
-		{
-			// Check Schedulability -> Non-concurrent approaches
-			resp_time_rd.clear();
-			req_blocking_rd.clear();
-			resp_time_jd.clear();
-			sched_flag_rd = worst_fit_decreasing(task_vector, num_cores, REQUEST_DRIVEN, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_jd = worst_fit_decreasing(task_vector, num_cores, JOB_DRIVEN, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_hybrid = worst_fit_decreasing(task_vector, num_cores, HYBRID, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			
-			// Check Schedulability -> Concurrent approaches (simple)
-			resp_time_rd.clear();
-			req_blocking_rd.clear();
-			resp_time_jd.clear();
-			job_blocking_jd.clear();
-			sched_flag_rd_conc_simple = worst_fit_decreasing(task_vector, num_cores, REQUEST_DRIVEN_CONC_SIMPLE, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_jd_conc = worst_fit_decreasing(task_vector, num_cores, JOB_DRIVEN_CONC, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			
-			// Check Schedulability -> Concurrent approaches (complex)
-			resp_time_rd.clear();
-			req_blocking_rd.clear();
-			resp_time_jd.clear();
-			job_blocking_jd.clear();
-			sched_flag_rd_conc = worst_fit_decreasing(task_vector, num_cores,REQUEST_DRIVEN_CONC, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_jd_conc_ro = worst_fit_decreasing(task_vector, num_cores, JOB_DRIVEN_CONC_RO, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_hybrid_conc = worst_fit_decreasing(task_vector, num_cores, HYBRID_CONC, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_fifo_conc = worst_fit_decreasing(task_vector, num_cores, FIFO_CONC, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-
-			if (DEBUG)
-			{
-				std::cout << "Schedulability WFD:" << "\n";
-				std::cout << "Request-Driven        : " << sched_flag_rd << "\n";
-				std::cout << "Job-Driven            : " << sched_flag_jd << "\n";
-				std::cout << "Hybrid                : " << sched_flag_hybrid << "\n";
-				std::cout << "Request-Driven-Conc-S : " << sched_flag_rd_conc_simple << "\n";
-				std::cout << "Job-Driven-Conc       : " << sched_flag_jd_conc << "\n";
-				std::cout << "Request-Driven-Conc   : " << sched_flag_rd_conc << "\n";
-				std::cout << "Job-Driven-Conc-RO    : " << sched_flag_jd_conc_ro << "\n";
-				std::cout << "Hybrid-Conc           : " << sched_flag_hybrid_conc << "\n";
-				std::cout << "FIFO-Conc             : " << sched_flag_fifo_conc << "\n";
-			// std::cin.get();
-			}
+	/* initialize random seed: */
+  	srand (time(NULL));
 
-			// Update the schedulability counters
-			if (sched_flag_rd == 0)
-				counter_rd++;
+	// The stopping point of a pipelined run would depend on the order the workers finish in
+	if (ci_width > 0 && pipeline_workers > 0)
+	{
+		std::cout << "Sequential sampling needs the sequential mode, Exiting ..\n";
+		exit(1);
+	}
 
-			if (sched_flag_jd == 0)
-				counter_jd++;
+	// Checkpoints need a random stream that can be saved and a run that can be continued in order
+	if (!checkpoint_filename.empty())
+	{
+		if (pipeline_workers > 0 || corpus_mode == CORPUS_WRITE || result_log_flag)
+		{
+			std::cout << "Checkpoints need the sequential mode without corpus recording or result log, Exiting ..\n";
+			exit(1);
+		}
 
-			if (sched_flag_hybrid == 0)
-				counter_hybrid++;
+		seed_taskset_generator(rand());
+		if (resume_flag)
+		{
+			if (load_checkpoint(checkpoint_filename, run_args, taskset_counter, counters) != 0)
+			{
+				std::cout << "Cannot resume from " << checkpoint_filename << ", Exiting ..\n";
+				exit(1);
+			}
+			std::cout << "Resumed at taskset " << taskset_counter << "\n";
+		}
+	}
+	else if (resume_flag)
+	{
+		std::cout << "--resume needs --checkpoint <file>, Exiting ..\n";
+		exit(1);
+	}
 
-			if (sched_flag_rd_conc == 0)
-				counter_rd_conc++;
+	if (pipeline_workers > 0)
+		run_pipeline(gen_params, taskset_count, num_cores, min_core_flag, pipeline_workers, 
+					 corpus_mode == CORPUS_READ ? &corpus_reader : NULL, 
+					 corpus_mode == CORPUS_WRITE ? &corpus_writer : NULL, 
+					 result_log_flag ? &result_log : NULL, counters);
 
-			if (sched_flag_jd_conc == 0)
-				counter_jd_conc++;
+	// Index of the taskset the common random numbers were last seeded for
+	int crn_index = -1;
 
-			if (sched_flag_rd_conc_simple == 0)
-				counter_rd_conc_simple++;
+	while (pipeline_workers <= 0 && taskset_counter < taskset_count)
+	{
+		if (DEBUG)
+			std::cout << "Taskset " << taskset_counter << "\n";
 
-			if (sched_flag_jd_conc_ro == 0)
-				counter_jd_conc_ro++;
+		// Retries of a failed generation continue the taskset's stream
+		if (crn_seed != 0 && crn_index != taskset_counter)
+		{
+			seed_taskset_stream(crn_seed, taskset_counter);
+			crn_index = taskset_counter;
+		}
+		// If the generation failed try again
+		if (obtain_taskset(gen_params, corpus_mode == CORPUS_READ ? &corpus_reader : NULL, 
+						   corpus_mode == CORPUS_WRITE ? &corpus_writer : NULL, taskset_counter, arena, task_vector) != 0)
+			continue;
 
-			if (sched_flag_hybrid_conc == 0)
-				counter_hybrid_conc++;
+		analyse_taskset(task_vector, num_cores, min_core_flag, result);
+		result.index = taskset_counter;
+		reduce_taskset_result(result, counters);
+		if (result_log_flag)
+			log_taskset_result(gen_params, num_cores, min_core_flag, result, result_log);
+		taskset_counter++;
 
-			if (sched_flag_fifo_conc == 0)
-				counter_fifo_conc++;
-		}
-		
-		// Check Schedulability -> Using SyncAware WFD as task partitioning
+		// Stop once every test's schedulable fraction is known to the target precision
+		double max_width;
+		if (ci_width > 0 && taskset_counter >= CI_MIN_TASKSETS && 
+			sample_converged(counters, taskset_counter, min_core_flag, ci_width, max_width))
 		{
-			// Check Schedulability -> Non-concurrent approaches
-			resp_time_rd.clear();
-			req_blocking_rd.clear();
-			resp_time_jd.clear();
-			sched_flag_rd = sync_aware_worst_fit_decreasing(task_vector, num_cores, REQUEST_DRIVEN, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_jd = sync_aware_worst_fit_decreasing(task_vector, num_cores, JOB_DRIVEN, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_hybrid = sync_aware_worst_fit_decreasing(task_vector, num_cores, HYBRID, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			
-			// Check Schedulability -> Concurrent approaches (simple)
-			resp_time_rd.clear();
-			req_blocking_rd.clear();
-			resp_time_jd.clear();
-			job_blocking_jd.clear();
-			sched_flag_rd_conc_simple = sync_aware_worst_fit_decreasing(task_vector, num_cores, REQUEST_DRIVEN_CONC_SIMPLE, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_jd_conc = sync_aware_worst_fit_decreasing(task_vector, num_cores, JOB_DRIVEN_CONC, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			
-			// Check Schedulability -> Concurrent approaches (complex)
-			resp_time_rd.clear();
-			req_blocking_rd.clear();
-			resp_time_jd.clear();
-			job_blocking_jd.clear();
-			sched_flag_rd_conc = sync_aware_worst_fit_decreasing(task_vector, num_cores,REQUEST_DRIVEN_CONC, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_jd_conc_ro = sync_aware_worst_fit_decreasing(task_vector, num_cores, JOB_DRIVEN_CONC_RO, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_hybrid_conc = sync_aware_worst_fit_decreasing(task_vector, num_cores, HYBRID_CONC, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-			sched_flag_fifo_conc = sync_aware_worst_fit_decreasing(task_vector, num_cores, FIFO_CONC, resp_time_rd, resp_time_jd, 
-												 req_blocking_rd, job_blocking_jd, ComparePriorityRMS);
-
-			if (DEBUG)
-			{
-				std::cout << "Schedulability SA-WFD :" << "\n";
-				std::cout << "Request-Driven        : " << sched_flag_rd << "\n";
-				std::cout << "Job-Driven            : " << sched_flag_jd << "\n";
-				std::cout << "Hybrid                : " << sched_flag_hybrid << "\n";
-				std::cout << "Request-Driven-Conc-S : " << sched_flag_rd_conc_simple << "\n";
-				std::cout << "Job-Driven-Conc       : " << sched_flag_jd_conc << "\n";
-				std::cout << "Request-Driven-Conc   : " << sched_flag_rd_conc << "\n";
-				std::cout << "Job-Driven-Conc-RO    : " << sched_flag_jd_conc_ro << "\n";
-				std::cout << "Hybrid-Conc           : " << sched_flag_hybrid_conc << "\n";
-				std::cout << "FIFO-Conc             : " << sched_flag_fifo_conc << "\n";
-				// std::cin.get();
-			}
-
-			// Update the schedulability counters
-			if (sched_flag_rd == 0)
-				sa_counter_rd++;
+			std::cout << "Converged after " << taskset_counter << " tasksets (widest interval " << max_width << ")\n";
+			break;
+		}
 
-			if (sched_flag_jd == 0)
-				sa_counter_jd++;
+		if (!checkpoint_filename.empty() && taskset_counter % CHECKPOINT_INTERVAL == 0 && taskset_counter < taskset_count &&
+			save_checkpoint(checkpoint_filename, run_args, taskset_counter, counters) != 0)
+			std::cout << "Cannot write checkpoint " << checkpoint_filename << "\n";
+	}
 
-			if (sched_flag_hybrid == 0)
-				sa_counter_hybrid++;
+	// Record the corpus once every taskset is in it
+	if (corpus_mode == CORPUS_WRITE)
+	{
+		if (corpus_writer.close() != 0)
+			exit(1);
+		std::cout << "Corpus Tasksets: " << corpus_writer.getNumTasksets() << "\n";
+	}
 
-			if (sched_flag_rd_conc == 0)
-				sa_counter_rd_conc++;
+	// Wait for the writer to drain the result log
+	if (result_log_flag)
+	{
+		if (result_log.close() != 0)
+			exit(1);
+		std::cout << "Result Log Rows: " << result_log.getNumRows() << "\n";
+	}
 
-			if (sched_flag_jd_conc == 0)
-				sa_counter_jd_conc++;
+	// The averages and the output are over the tasksets actually analysed
+	if (ci_width > 0)
+		taskset_count = taskset_counter;
 
-			if (sched_flag_rd_conc_simple == 0)
-				sa_counter_rd_conc_simple++;
+	// Compute the Average
+	double average_gpu_util = counters.average_gpu_util/taskset_count;
+	double average_cpu_util = counters.average_cpu_util/taskset_count;
 
-			if (sched_flag_jd_conc_ro == 0)
-				sa_counter_jd_conc_ro++;
+	// Report the verdict cache counters, summed over the tasksets analysed by this run
+	std::cout << "Verdict Cache Hits/Misses/Evictions: " << counters.cache_hits << "/" << counters.cache_misses << "/" 
+			  << counters.cache_evictions << "\n";
 
-			if (sched_flag_hybrid_conc == 0)
-				sa_counter_hybrid_conc++;
+	// Report the utilization sampler counters (only UUniFast-Discard discards draws)
+	long util_draws, util_discards, util_failures;
+	get_util_sampler_stats(util_draws, util_discards, util_failures);
+	std::cout << "Util. Draws/Discards/Failures: " << util_draws << "/" << util_discards << "/" << util_failures;
+	if (util_draws > 0)
+		std::cout << " (discard rate " << double(util_discards)/util_draws << ")";
+	std::cout << "\n";
 
-			if (sched_flag_fifo_conc == 0)
-				sa_counter_fifo_conc++;
+	// Report the minimum core count distribution -> one line per test: infeasible, then 1 .. num_cores
+	if (min_core_flag)
+	{
+		std::cout << "Tasksets: " << taskset_count << "\n";
+		std::cout << "Avg. CPU Util :" << average_cpu_util << "\n";
+		std::cout << "Avg. GPU Util :" << average_gpu_util << "\n";
+		std::cout << "Minimum Cores (infeasible, 1 .. " << num_cores << ")\n";
+		for (int test = 0; test < INVALID; test++)
+		{
+			std::cout << get_sched_type_label(test) << ":";
+			if (file_flag == 1)
+				outfile << average_cpu_util << "," << average_gpu_util << "," << taskset_count << "," << test;
+			for (int cores = 0; cores <= num_cores; cores++)
+			{
+				std::cout << " " << counters.min_core_histogram[test][cores];
+				if (file_flag == 1)
+					outfile << "," << counters.min_core_histogram[test][cores];
+			}
+			std::cout << "\n";
+			if (file_flag == 1)
+				outfile << "\n";
 		}
-		// Compute utilization values for energy calculations
-		true_cpu_util = get_taskset_cpu_util(task_vector);
-		true_gpu_util = get_taskset_gpu_util(task_vector);
+		if (file_flag == 1)
+			outfile.close();
 
-		// Update average utilization values
-		average_gpu_util = average_gpu_util + true_gpu_util;
-		average_cpu_util = average_cpu_util + true_cpu_util;
-		taskset_counter++;
+		// The run is complete once its line is written
+		if (!checkpoint_filename.empty())
+			std::remove(checkpoint_filename.c_str());
+		return 0;
 	}
 
-	// Compute the Average
-	average_gpu_util = average_gpu_util/taskset_count;
-	average_cpu_util = average_cpu_util/taskset_count;
-
 	// Write values to file
 	if (file_flag == 1)
 	{	
 		outfile << average_cpu_util << ","
 		        << average_gpu_util << ","
-		        << taskset_count << ","
-		        << counter_rd << ","
-		        << counter_jd << ","
-		        << counter_hybrid << ","
-		        << counter_rd_conc << ","
-		        << counter_jd_conc << ","
-		        << counter_rd_conc_simple << ","
-		        << counter_jd_conc_ro << ","
-		        << counter_hybrid_conc << ","
-		        << counter_fifo_conc << ","
-		        << sa_counter_rd << ","
-		        << sa_counter_jd << ","
-		        << sa_counter_hybrid << ","
-		        << sa_counter_rd_conc << ","
-		        << sa_counter_jd_conc << ","
-		        << sa_counter_rd_conc_simple << ","
-		        << sa_counter_jd_conc_ro << ","
-		        << sa_counter_hybrid_conc << ","
-		        << sa_counter_fifo_conc << "\n";
+		        << taskset_count;
+		for (int test = 0; test < INVALID; test++)
+			outfile << "," << counters.wfd_counter[csv_order[test]];
+		for (int test = 0; test < INVALID; test++)
+			outfile << "," << counters.sa_counter[csv_order[test]];
+		outfile << "\n";
 		outfile.close();
 	}
 
+	// The run is complete once its line is written
+	if (!checkpoint_filename.empty())
+		std::remove(checkpoint_filename.c_str());
+
 	std::cout << "Tasksets: " << taskset_count << "\n";
 	std::cout << "Avg. CPU Util :" << average_cpu_util << "\n";
 	std::cout << "Avg. GPU Util :" << average_gpu_util << "\n";
 	
 	std::cout << "WFD Schedulability " << "\n";
-	std::cout << "Request-Driven        : " << counter_rd << "\n";
-	std::cout << "Job-Driven            : " << counter_jd << "\n";
-	std::cout << "Hybrid                : " << counter_hybrid << "\n";
-	std::cout << "Request-Driven-Conc-S : " << counter_rd_conc_simple << "\n";
-	std::cout << "Job-Driven-Conc       : " << counter_jd_conc << "\n";
-	std::cout << "Request-Driven-Conc   : " << counter_rd_conc << "\n";
-	std::cout << "Job-Driven-Conc-RO    : " << counter_jd_conc_ro << "\n";
-	std::cout << "Hybrid-Conc           : " << counter_hybrid_conc << "\n";
-	std::cout << "FIFO-Conc             : " << counter_fifo_conc << "\n";
+	for (int test = 0; test < INVALID; test++)
+		std::cout << get_sched_type_label(test) << ": " << counters.wfd_counter[test] << "\n";
+
+	if (local_search_restarts > 0)
+		std::cout << "Local-Search Recovered: " << counters.local_search_recovered << "\n";
+
+	if (semi_partitioning)
+		std::cout << "Semi-Part. Recovered  : " << counters.semi_partitioned_recovered << "\n";
 
 	std::cout << "SA-WFD Schedulability " << "\n";
-	std::cout << "Request-Driven        : " << sa_counter_rd << "\n";
-	std::cout << "Job-Driven            : " << sa_counter_jd << "\n";
-	std::cout << "Hybrid                : " << sa_counter_hybrid << "\n";
-	std::cout << "Request-Driven-Conc-S : " << sa_counter_rd_conc_simple << "\n";
-	std::cout << "Job-Driven-Conc       : " << sa_counter_jd_conc << "\n";
-	std::cout << "Request-Driven-Conc   : " << sa_counter_rd_conc << "\n";
-	std::cout << "Job-Driven-Conc-RO    : " << sa_counter_jd_conc_ro << "\n";
-	std::cout << "Hybrid-Conc           : " << sa_counter_hybrid_conc << "\n";
-	std::cout << "FIFO-Conc             : " << sa_counter_fifo_conc << "\n";
+	for (int test = 0; test < INVALID; test++)
+		std::cout << get_sched_type_label(test) << ": " << counters.sa_counter[test] << "\n";
+
+	std::cout << "SA-WFD Avg. Cores Hosting GPU Tasks " << "\n";
+	for (int test = 0; test < INVALID; test++)
+	{
+		std::cout << get_sched_type_label(test) << ": ";
+		if (counters.sa_partitions[test] > 0)
+			std::cout << double(counters.sa_gpu_cores[test])/counters.sa_partitions[test] << "\n";
+		else
+			std::cout << "-" << "\n";
+	}
 
 	return 0;
-}
\ No newline at end of file
+}
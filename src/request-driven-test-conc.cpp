@@ -35,10 +35,11 @@
 #include "request-driven-test-conc.hpp"
 #include "indirect-cis.hpp"
 #include "taskset.hpp"
+#include "sched-config.hpp"
 #include "config.hpp"
 
-// Wavefront liquefaction flag
-bool wavefront_liquefaction = false;
+// Wavefront liquefaction flag (per thread, so partitioners may run the test concurrently)
+thread_local bool wavefront_liquefaction = false;
 
 /**************** Calculate Prioritized Blocking using the request-driven approach sub-routine ********************/ 
 double calculate_prioritized_blocking_rdc(unsigned int index, const std::vector<Task> &task_vector)
@@ -68,7 +69,7 @@ double calculate_liquefaction_mass_rdc(unsigned int index, unsigned int req_inde
 	double beta;
 	unsigned int num_gpu_segments;
 	double fraction = task_vector[index].getF(req_index);
-	double blocking_fraction = 1 - fraction + (1.0/double(GPU_FRACTION_GRANULARITY));
+	double blocking_fraction = 1 - fraction + (get_sched_config().gpu_fraction_unit);
 	double req_fraction;
 
 	// Iterate over all tasks to calculate blocking
@@ -107,7 +108,7 @@ double calculate_request_direct_blocking_rdc(unsigned int index, unsigned int re
 	double init_blocking = 0;
 	unsigned int num_gpu_segments;
 	double fraction = task_vector[index].getF(req_index);
-	double blocking_fraction = 1 - fraction + (1.0/double(GPU_FRACTION_GRANULARITY));
+	double blocking_fraction = 1 - fraction + (get_sched_config().gpu_fraction_unit);
 	double left_over_fraction = blocking_fraction;
 	double wavefront_req_fraction = 0;
 	double liquefied_mass = 0 ;
@@ -121,7 +122,7 @@ double calculate_request_direct_blocking_rdc(unsigned int index, unsigned int re
 	std::vector<double> wavefront_length;
 	std::vector<double> wavefront_bin_fraction;
 
-	double Hl_max = MAX_PERIOD+1; // Set to a large number (MAX_PERIOD is biggest possible)
+	double Hl_max = SEGMENT_SEARCH_UNBOUNDED; // Above any segment, the search starts from the biggest
 
 	// Return 0 blocking if task has no GPU execution
 	if(task_vector[index].getTotalGe() == 0)
@@ -286,9 +287,9 @@ double calculate_interference_rdc(unsigned int index, const std::vector<Task> &t
 			continue;
 
 		if (task_vector[i].getTotalGe() != 0)
-			interference = interference + ceil((resp_time + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
+			interference = interference + ceil((resp_time + task_vector[i].getJ() + resp_time_hp[i] - ((task_vector[i].getC()+task_vector[i].getTotalGm())))/task_vector[i].getT())*(task_vector[i].getC()+task_vector[i].getTotalGm());
 		else
-			interference = interference + ceil((resp_time)/task_vector[i].getT())*(task_vector[i].getC());
+			interference = interference + ceil((resp_time + task_vector[i].getJ())/task_vector[i].getT())*(task_vector[i].getC());
 	}
 	return interference;
 }
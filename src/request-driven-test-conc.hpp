@@ -44,4 +44,22 @@ int check_schedulability_request_driven_conc(std::vector<Task> &task_vector,
 										std::vector<std::vector<double>> &req_blocking,
 										bool simple_flag);
 
+/**************** Calculate Liquefaction Mass ********************/ 
+/* Params: index: index of the task under analysis
+		   req_index: index of its GPU request
+		   instant: length of the blocking window
+		   task_vector: vector of tasks 
+		   resp_time_hp: response times (deadlines for tasks not analysed yet)
+   Returns: GPU mass that can block the request within the window */
+double calculate_liquefaction_mass_rdc(unsigned int index, unsigned int req_index, double instant, const std::vector<Task> &task_vector, 
+									   const std::vector<double> &resp_time_hp);
+
+/**************** The Calculate High-Priority response time using the concurrent request-driven approach ********************/ 
+/* Params: index: number of highest-priority tasks to analyse (tasks are in priority order)
+		   task_vector: vector of tasks 
+		   req_blocking: vector of vectors of per-request direct blocking faced (populated by the function)
+   Returns: response times of the first index tasks */
+std::vector<double> calculate_hp_resp_time_rdc(unsigned int index, const std::vector<Task> &task_vector, 
+											   std::vector<std::vector<double>> &req_blocking);
+
 #endif
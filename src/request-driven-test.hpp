@@ -42,4 +42,12 @@ int check_schedulability_request_driven(std::vector<Task> &task_vector,
 										std::vector<double> &resp_time,
 										std::vector<std::vector<double>> &req_blocking);
 
+/**************** The Calculate High-Priority response time sub-routine using the request-driven approach ********************/ 
+/* Params: index: number of highest-priority tasks to analyse (tasks are in priority order)
+		   task_vector: vector of tasks 
+		   req_blocking: vector of vectors of per-request direct blocking faced (populated by the function)
+   Returns: response times of the first index tasks */
+std::vector<double> calculate_hp_resp_time_rd(unsigned int index, const std::vector<Task> &task_vector, 
+											  std::vector<std::vector<double>> &req_blocking);
+
 #endif
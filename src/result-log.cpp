@@ -0,0 +1,367 @@
+/*
+ * @file result-log.cpp
+ * @brief Per-taskset columnar result log implementation
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+// Include Internal Headers
+#include "result-log.hpp"
+#include "config.hpp"
+
+/**************** Visit the columns of a row group in file order ********************/ 
+/* Params: columns   : the row group
+		   visitor   : called with each column and its length
+		   num_rows  : rows in the group
+		   num_values: response times per response time column */
+template <typename Visitor>
+static void for_each_column(result_columns_t &columns, Visitor &visitor, size_t num_rows, size_t num_values)
+{
+	visitor(columns.taskset_index, num_rows);
+	visitor(columns.mode, num_rows);
+	visitor(columns.harmonic_flag, num_rows);
+	visitor(columns.max_number_tasks, num_rows);
+	visitor(columns.number_gpu_segments, num_rows);
+	visitor(columns.num_cores, num_rows);
+	visitor(columns.gpu_task_fraction, num_rows);
+	visitor(columns.utilization_bound, num_rows);
+	visitor(columns.gpu_utilization_bound, num_rows);
+	visitor(columns.max_gpu_fraction, num_rows);
+	visitor(columns.cpu_util, num_rows);
+	visitor(columns.gpu_util, num_rows);
+	visitor(columns.num_tasks, num_rows);
+	for (int test = 0; test < INVALID; test++)
+		visitor(columns.wfd_verdict[test], num_rows);
+	for (int test = 0; test < INVALID; test++)
+		visitor(columns.sa_verdict[test], num_rows);
+	for (int test = 0; test < INVALID; test++)
+		visitor(columns.wfd_resp_time[test], num_values);
+	for (int test = 0; test < INVALID; test++)
+		visitor(columns.sa_resp_time[test], num_values);
+}
+
+// Column writer
+struct ColumnWriter {
+	std::ofstream &outfile;
+	ColumnWriter(std::ofstream &file) : outfile(file) {}
+	template <typename T> void operator()(std::vector<T> &column, size_t count) {
+		outfile.write((const char *) column.data(), count*sizeof(T));
+	}
+};
+
+// Column reader
+struct ColumnReader {
+	std::ifstream &infile;
+	ColumnReader(std::ifstream &file) : infile(file) {}
+	template <typename T> void operator()(std::vector<T> &column, size_t count) {
+		column.resize(count);
+		infile.read((char *) column.data(), count*sizeof(T));
+	}
+};
+
+/**************** Append the response times of a row, NaN for the tasks without one ********************/ 
+static void append_resp_times(std::vector<double> &column, const std::vector<double> &resp_time, unsigned int num_tasks)
+{
+	for (unsigned int index = 0; index < num_tasks; index++)
+	{
+		if (index < resp_time.size())
+			column.push_back(resp_time[index]);
+		else
+			column.push_back(std::numeric_limits<double>::quiet_NaN());
+	}
+}
+
+/**************** Result Log ********************/ 
+ResultLog::ResultLog()
+{
+	opened = false;
+	stopping = false;
+	write_error = false;
+	num_rows = 0;
+}
+
+ResultLog::~ResultLog()
+{
+	close();
+}
+
+int ResultLog::open(const std::string &filename)
+{
+	result_log_header_t header;
+
+	if (opened)
+		return -1;
+
+	outfile.open(filename, std::ios_base::binary | std::ios_base::trunc);
+	if (!outfile)
+	{
+		std::cerr << "Result log: cannot write " << filename << "\n";
+		return -1;
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, RESULT_LOG_MAGIC, sizeof(header.magic));
+	header.version = RESULT_LOG_VERSION;
+	header.num_tests = INVALID;
+	outfile.write((const char *) &header, sizeof(header));
+
+	opened = true;
+	stopping = false;
+	write_error = false;
+	num_rows = 0;
+	writer = std::thread(&ResultLog::writeGroups, this);
+	return 0;
+}
+
+void ResultLog::append(const result_record_t &record)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	if (!opened)
+		return;
+
+	current.taskset_index.push_back(record.taskset_index);
+	current.mode.push_back(record.mode);
+	current.harmonic_flag.push_back(record.harmonic_flag);
+	current.max_number_tasks.push_back(record.max_number_tasks);
+	current.number_gpu_segments.push_back(record.number_gpu_segments);
+	current.num_cores.push_back(record.num_cores);
+	current.gpu_task_fraction.push_back(record.gpu_task_fraction);
+	current.utilization_bound.push_back(record.utilization_bound);
+	current.gpu_utilization_bound.push_back(record.gpu_utilization_bound);
+	current.max_gpu_fraction.push_back(record.max_gpu_fraction);
+	current.cpu_util.push_back(record.cpu_util);
+	current.gpu_util.push_back(record.gpu_util);
+	current.num_tasks.push_back(record.num_tasks);
+	for (int test = 0; test < INVALID; test++)
+	{
+		current.wfd_verdict[test].push_back(record.wfd_verdict[test]);
+		current.sa_verdict[test].push_back(record.sa_verdict[test]);
+		append_resp_times(current.wfd_resp_time[test], record.wfd_resp_time[test], record.num_tasks);
+		append_resp_times(current.sa_resp_time[test], record.sa_resp_time[test], record.num_tasks);
+	}
+	num_rows++;
+
+	// Hand the group over, the writer does the I/O
+	if (current.taskset_index.size() >= RESULT_LOG_ROWS_PER_GROUP)
+	{
+		full.push_back(result_columns_t());
+		std::swap(full.back(), current);
+		groups_ready.notify_one();
+	}
+}
+
+int ResultLog::close()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (!opened)
+			return -1;
+		if (!current.taskset_index.empty())
+		{
+			full.push_back(result_columns_t());
+			std::swap(full.back(), current);
+		}
+		stopping = true;
+		groups_ready.notify_one();
+	}
+
+	writer.join();
+	outfile.close();
+	opened = false;
+	if (write_error || !outfile)
+		return -1;
+	return 0;
+}
+
+unsigned long ResultLog::getNumRows() const
+{
+	return num_rows;
+}
+
+void ResultLog::writeGroups()
+{
+	result_columns_t group;
+	ColumnWriter column_writer(outfile);
+	uint32_t group_header[2];
+	uint64_t num_values;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			groups_ready.wait(guard, [this]() { return stopping || !full.empty(); });
+			if (full.empty())
+				return;
+			std::swap(group, full.front());
+			full.pop_front();
+		}
+
+		group_header[0] = group.taskset_index.size();
+		group_header[1] = 0;
+		num_values = group.wfd_resp_time[0].size();
+		outfile.write((const char *) group_header, sizeof(group_header));
+		outfile.write((const char *) &num_values, sizeof(num_values));
+		for_each_column(group, column_writer, group_header[0], num_values);
+		if (!outfile)
+			write_error = true;
+	}
+}
+
+/**************** Read and check the header of a result log ********************/ 
+int result_log_read_header(std::ifstream &infile)
+{
+	result_log_header_t header;
+
+	infile.read((char *) &header, sizeof(header));
+	if (!infile || memcmp(header.magic, RESULT_LOG_MAGIC, sizeof(header.magic)) != 0 || 
+		header.version != RESULT_LOG_VERSION || header.num_tests != INVALID)
+		return -1;
+	return 0;
+}
+
+/**************** Read the next row group of a result log ********************/ 
+int result_log_read_group(std::ifstream &infile, result_columns_t &columns)
+{
+	ColumnReader column_reader(infile);
+	uint32_t group_header[2];
+	uint64_t num_values;
+
+	infile.read((char *) group_header, sizeof(group_header));
+	if (infile.gcount() == 0)
+		return 0;
+	infile.read((char *) &num_values, sizeof(num_values));
+	if (!infile)
+		return -1;
+
+	for_each_column(columns, column_reader, group_header[0], num_values);
+	if (!infile)
+		return -1;
+	return 1;
+}
+
+/**************** Check whether a test admits a taskset that another test rejects ********************/ 
+static bool verdicts_disagree(const std::vector<int8_t> *verdict, size_t row)
+{
+	bool admitted = false, rejected = false;
+	for (int test = 0; test < INVALID; test++)
+	{
+		admitted = admitted || verdict[test][row] == VERDICT_ADMITTED;
+		rejected = rejected || verdict[test][row] == VERDICT_REJECTED;
+	}
+	return admitted && rejected;
+}
+
+/**************** Print a result log as CSV ********************/ 
+int result_log_dump(const std::string &filename, bool disagreements_only, std::ostream &out)
+{
+	std::ifstream infile(filename, std::ios_base::binary);
+	result_columns_t columns;
+	// Tasksets admitted by the first test and rejected by the second, under WFD and SA-WFD
+	std::vector<std::vector<long>> wfd_pairs(INVALID, std::vector<long>(INVALID, 0));
+	std::vector<std::vector<long>> sa_pairs(INVALID, std::vector<long>(INVALID, 0));
+	int retval;
+
+	if (!infile || result_log_read_header(infile) != 0)
+	{
+		std::cerr << "Result log: cannot read " << filename << "\n";
+		return -1;
+	}
+
+	out << "taskset_index,mode,harmonic_flag,max_number_tasks,number_gpu_segments,num_cores,gpu_task_fraction,"
+		<< "utilization_bound,gpu_utilization_bound,max_gpu_fraction,cpu_util,gpu_util,num_tasks";
+	for (int test = 0; test < INVALID; test++)
+		out << ",wfd_" << sched_type_keys[test];
+	for (int test = 0; test < INVALID; test++)
+		out << ",sa_" << sched_type_keys[test];
+	out << "\n";
+
+	while ((retval = result_log_read_group(infile, columns)) == 1)
+	{
+		for (size_t row = 0; row < columns.taskset_index.size(); row++)
+		{
+			bool wfd_disagree = verdicts_disagree(columns.wfd_verdict, row);
+			bool sa_disagree = verdicts_disagree(columns.sa_verdict, row);
+			for (int a = 0; a < INVALID; a++)
+			{
+				for (int b = 0; b < INVALID; b++)
+				{
+					if (columns.wfd_verdict[a][row] == VERDICT_ADMITTED && columns.wfd_verdict[b][row] == VERDICT_REJECTED)
+						wfd_pairs[a][b]++;
+					if (columns.sa_verdict[a][row] == VERDICT_ADMITTED && columns.sa_verdict[b][row] == VERDICT_REJECTED)
+						sa_pairs[a][b]++;
+				}
+			}
+			if (disagreements_only && !wfd_disagree && !sa_disagree)
+				continue;
+
+			out << columns.taskset_index[row] << "," << columns.mode[row] << "," << columns.harmonic_flag[row] << ","
+				<< columns.max_number_tasks[row] << "," << columns.number_gpu_segments[row] << "," << columns.num_cores[row] << ","
+				<< columns.gpu_task_fraction[row] << "," << columns.utilization_bound[row] << "," 
+				<< columns.gpu_utilization_bound[row] << "," << columns.max_gpu_fraction[row] << "," << columns.cpu_util[row] << ","
+				<< columns.gpu_util[row] << "," << columns.num_tasks[row];
+			for (int test = 0; test < INVALID; test++)
+				out << "," << (int) columns.wfd_verdict[test][row];
+			for (int test = 0; test < INVALID; test++)
+				out << "," << (int) columns.sa_verdict[test][row];
+			out << "\n";
+		}
+	}
+	if (retval < 0)
+	{
+		std::cerr << "Result log: " << filename << " is truncated\n";
+		return -1;
+	}
+
+	if (disagreements_only)
+	{
+		for (int partitioning = 0; partitioning < 2; partitioning++)
+		{
+			const std::vector<std::vector<long>> &pairs = (partitioning == 0) ? wfd_pairs : sa_pairs;
+			out << "# " << (partitioning == 0 ? "WFD" : "SA-WFD") << ": tasksets admitted by the row test and rejected by the column test\n";
+			out << "#";
+			for (int b = 0; b < INVALID; b++)
+				out << "," << sched_type_keys[b];
+			out << "\n";
+			for (int a = 0; a < INVALID; a++)
+			{
+				out << "# " << sched_type_keys[a];
+				for (int b = 0; b < INVALID; b++)
+					out << "," << pairs[a][b];
+				out << "\n";
+			}
+		}
+	}
+	return 0;
+}
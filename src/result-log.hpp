@@ -0,0 +1,159 @@
+/*
+ * @file result-log.hpp
+ * @brief Per-taskset columnar result log header
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RESULT_LOG_HPP
+#define RESULT_LOG_HPP
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include "task_partitioning.hpp"
+
+/* Result log layout (native byte order): header, then row groups until the end of the file
+   row group: uint32 num_rows, uint32 reserved, uint64 num_values (tasks over all the rows), then one contiguous
+   array per column in the order of result_columns_t, the response time columns hold num_tasks values per row
+   (in priority order, NaN if the partitioning failed) */
+#define RESULT_LOG_MAGIC "GPURES01"
+#define RESULT_LOG_VERSION 1
+
+/* Verdict columns */
+#define VERDICT_REJECTED 0
+#define VERDICT_ADMITTED 1
+#define VERDICT_NOT_RUN -1
+
+typedef struct result_log_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t num_tests;				// verdict and response time columns per partitioning (INVALID)
+} result_log_header_t;
+
+/* Result of one taskset */
+typedef struct result_record {
+	uint64_t taskset_index;
+	// Generation parameters
+	int32_t mode;
+	int32_t harmonic_flag;
+	int32_t max_number_tasks;
+	int32_t number_gpu_segments;
+	int32_t num_cores;
+	double gpu_task_fraction;
+	double utilization_bound;
+	double gpu_utilization_bound;
+	double max_gpu_fraction;
+	// Utilizations
+	double cpu_util;
+	double gpu_util;
+	// Verdicts and response times (num_tasks each) per test, under WFD and SA-WFD
+	uint32_t num_tasks;
+	int8_t wfd_verdict[INVALID];
+	int8_t sa_verdict[INVALID];
+	std::vector<double> wfd_resp_time[INVALID];
+	std::vector<double> sa_resp_time[INVALID];
+} result_record_t;
+
+/* One row group, a vector per column */
+typedef struct result_columns {
+	std::vector<uint64_t> taskset_index;
+	std::vector<int32_t> mode;
+	std::vector<int32_t> harmonic_flag;
+	std::vector<int32_t> max_number_tasks;
+	std::vector<int32_t> number_gpu_segments;
+	std::vector<int32_t> num_cores;
+	std::vector<double> gpu_task_fraction;
+	std::vector<double> utilization_bound;
+	std::vector<double> gpu_utilization_bound;
+	std::vector<double> max_gpu_fraction;
+	std::vector<double> cpu_util;
+	std::vector<double> gpu_util;
+	std::vector<uint32_t> num_tasks;
+	std::vector<int8_t> wfd_verdict[INVALID];
+	std::vector<int8_t> sa_verdict[INVALID];
+	std::vector<double> wfd_resp_time[INVALID];
+	std::vector<double> sa_resp_time[INVALID];
+} result_columns_t;
+
+/* Appends buffer rows in memory, full row groups are written by a background thread so that appending never waits on the file */
+class ResultLog
+{
+	// Constructor and destructor (the destructor closes the log)
+	public: ResultLog();
+	public: ~ResultLog();
+
+	// Create the log and start the writer, 0 on success
+	public: int open(const std::string &filename);
+
+	// Buffer the result of a taskset (thread-safe)
+	public: void append(const result_record_t &record);
+
+	// Write the remaining rows and stop the writer, 0 if every row group was written
+	public: int close();
+
+	public: unsigned long getNumRows() const;
+
+	// Writer thread
+	private: void writeGroups();
+
+	// Private Variables
+	private: std::ofstream outfile;
+	private: bool opened;
+	private: bool stopping;
+	private: bool write_error;
+	private: unsigned long num_rows;
+	private: result_columns_t current;			// group being filled
+	private: std::deque<result_columns_t> full;	// groups waiting for the writer
+	private: std::mutex lock;
+	private: std::condition_variable groups_ready;
+	private: std::thread writer;
+};
+
+/**************** Read the next row group of a result log ********************/ 
+/* Params: infile : result log positioned after the header (see result_log_read_header) or a previous group
+		   columns: the row group (populated by this function)
+   Returns: 1 if a group was read, 0 at the end of the log, -1 if the log is truncated */
+int result_log_read_group(std::ifstream &infile, result_columns_t &columns);
+
+/**************** Read and check the header of a result log ********************/ 
+/* Returns: 0 if the log was written with the same layout */
+int result_log_read_header(std::ifstream &infile);
+
+/**************** Print a result log as CSV ********************/ 
+/* One line per taskset: the generation parameters, the utilizations and the verdict of each test under WFD and SA-WFD
+   (VERDICT_ADMITTED, VERDICT_REJECTED or VERDICT_NOT_RUN); with disagreements_only, only the tasksets that a test admits
+   and another rejects under the same partitioning, then the number of such tasksets per pair of tests as '#' lines
+   Params: filename         : result log
+		   disagreements_only: print the disagreements only
+		   out              : CSV output
+   Returns: 0 on success, -1 if the log cannot be read (reported) */
+int result_log_dump(const std::string &filename, bool disagreements_only, std::ostream &out);
+
+#endif
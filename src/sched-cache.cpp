@@ -0,0 +1,200 @@
+/*
+ * @file sched-cache.cpp
+ * @brief Schedulability verdict cache keyed by a canonical (taskset, core mapping, sched_type) encoding
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard Library Imports */
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/* Internal Headers */
+#include "sched-cache.hpp"
+#include "sched-config.hpp"
+#include "config.hpp"
+
+/* A cached analysis, the canonical key is kept to rule out hash collisions */
+typedef struct sched_cache_node {
+	uint64_t hash;
+	std::vector<double> key;
+	sched_cache_entry_t entry;
+} sched_cache_node_t;
+
+/* The verdict cache of one thread, the least recently used entries are at the back of the list */
+typedef struct sched_cache {
+	std::list<sched_cache_node_t> entries;
+	std::unordered_map<uint64_t, std::list<sched_cache_node_t>::iterator> index;
+	unsigned long hits = 0;
+	unsigned long misses = 0;
+	unsigned long evictions = 0;
+} sched_cache_t;
+
+// Each thread analyses with its own cache, so the analysis workers never wait on each other; the capacity is shared
+static thread_local sched_cache_t thread_cache;
+static std::atomic<unsigned int> cache_capacity(SCHED_CACHE_MAX_ENTRIES);
+
+/**************** Evict the least recently used entries of the thread's cache down to a size ********************/ 
+static void trim_cache(sched_cache_t &cache, unsigned int max_entries)
+{
+	while (cache.entries.size() > max_entries)
+	{
+		cache.index.erase(cache.entries.back().hash);
+		cache.entries.pop_back();
+		cache.evictions++;
+	}
+}
+
+/**************** Build the canonical encoding of a taskset mapping ********************/ 
+// The test and the configuration read by the tests (GPU fraction unit), then the tasks in priority order:
+// C, D, T, release jitter, core id, number of segments, then Gm, Ge, F of each segment
+static void encode_taskset(const std::vector<Task> &task_vector, sched_type sched_mode, std::vector<double> &key)
+{
+	unsigned int num_gpu_segments;
+
+	key.clear();
+	key.push_back((double) sched_mode);
+	key.push_back(get_sched_config().gpu_fraction_unit);
+	for (unsigned int index = 0; index < task_vector.size(); index++)
+	{
+		num_gpu_segments = task_vector[index].getNumGPUSegments();
+		key.push_back(task_vector[index].getC());
+		key.push_back(task_vector[index].getD());
+		key.push_back(task_vector[index].getT());
+		key.push_back(task_vector[index].getJ());
+		key.push_back((double) task_vector[index].getCoreID());
+		key.push_back((double) num_gpu_segments);
+		for (unsigned int j = 0; j < num_gpu_segments; j++)
+		{
+			key.push_back(task_vector[index].getGm(j));
+			key.push_back(task_vector[index].getGe(j));
+			key.push_back(task_vector[index].getF(j));
+		}
+	}
+}
+
+/**************** FNV-1a hash of the canonical encoding ********************/ 
+static uint64_t hash_key(const std::vector<double> &key)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	uint64_t bits;
+
+	for (unsigned int index = 0; index < key.size(); index++)
+	{
+		std::memcpy(&bits, &key[index], sizeof(bits));
+		for (unsigned int byte = 0; byte < sizeof(bits); byte++)
+		{
+			hash = hash ^ ((bits >> (8*byte)) & 0xff);
+			hash = hash*1099511628211ULL;
+		}
+	}
+	return hash;
+}
+
+/**************** Set the maximum number of cached verdicts (0 disables the cache) ********************/ 
+void sched_cache_set_capacity(unsigned int max_entries)
+{
+	cache_capacity = max_entries;
+	trim_cache(thread_cache, max_entries);
+}
+
+/**************** Drop all cached verdicts (the counters are kept) ********************/ 
+void sched_cache_clear()
+{
+	thread_cache.entries.clear();
+	thread_cache.index.clear();
+}
+
+/**************** Look up the verdict of a taskset mapping ********************/ 
+int sched_cache_lookup(const std::vector<Task> &task_vector, sched_type sched_mode, sched_cache_entry_t &entry)
+{
+	std::vector<double> key;
+	uint64_t hash;
+
+	if (cache_capacity.load() == 0)
+		return -1;
+
+	encode_taskset(task_vector, sched_mode, key);
+	hash = hash_key(key);
+
+	std::unordered_map<uint64_t, std::list<sched_cache_node_t>::iterator>::iterator it = thread_cache.index.find(hash);
+	if (it == thread_cache.index.end() || it->second->key != key)
+	{
+		thread_cache.misses++;
+		return -1;
+	}
+
+	// Move to the front (most recently used)
+	thread_cache.entries.splice(thread_cache.entries.begin(), thread_cache.entries, it->second);
+	entry = it->second->entry;
+	thread_cache.hits++;
+	return 0;
+}
+
+/**************** Insert the verdict of a taskset mapping ********************/ 
+void sched_cache_insert(const std::vector<Task> &task_vector, sched_type sched_mode, const sched_cache_entry_t &entry)
+{
+	sched_cache_node_t node;
+	unsigned int capacity = cache_capacity.load();
+
+	if (capacity == 0)
+		return;
+
+	encode_taskset(task_vector, sched_mode, node.key);
+	node.hash = hash_key(node.key);
+	node.entry = entry;
+
+	// Replace an existing entry with the same hash (same mapping, or a collision)
+	std::unordered_map<uint64_t, std::list<sched_cache_node_t>::iterator>::iterator it = thread_cache.index.find(node.hash);
+	if (it != thread_cache.index.end())
+	{
+		thread_cache.entries.erase(it->second);
+		thread_cache.index.erase(it);
+	}
+
+	// Evict the least recently used entries, the capacity may have been lowered from another thread
+	trim_cache(thread_cache, capacity - 1);
+
+	thread_cache.entries.push_front(std::move(node));
+	thread_cache.index[thread_cache.entries.front().hash] = thread_cache.entries.begin();
+}
+
+/**************** Get the cache counters ********************/ 
+void sched_cache_get_stats(unsigned long &hits, unsigned long &misses, unsigned long &evictions)
+{
+	hits = thread_cache.hits;
+	misses = thread_cache.misses;
+	evictions = thread_cache.evictions;
+}
+
+/**************** Add the counters of another thread's cache ********************/ 
+void sched_cache_add_stats(unsigned long hits, unsigned long misses, unsigned long evictions)
+{
+	thread_cache.hits += hits;
+	thread_cache.misses += misses;
+	thread_cache.evictions += evictions;
+}
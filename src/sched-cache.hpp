@@ -0,0 +1,79 @@
+/*
+ * @file sched-cache.hpp
+ * @brief Schedulability verdict cache header
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SCHED_CACHE_HPP
+#define SCHED_CACHE_HPP
+
+/* Standard Library Imports */
+#include <vector>
+
+/* Internal Headers */
+#include "task.hpp"
+#include "task_partitioning.hpp"
+
+/* Verdict and response-time vectors of one analysis of a (taskset, core mapping, sched_type) */
+typedef struct sched_cache_entry {
+	int sched_flag;                                  // Verdict of the test (0 if schedulable)
+	std::vector<double> resp_time;                   // Response times of the chosen test
+	std::vector<double> resp_time_rd;                // Response times (request-driven approach)
+	std::vector<double> resp_time_jd;                // Response times (job-driven approach)
+	std::vector<std::vector<double>> req_blocking_rd; // Per-request direct blocking (request-driven approach)
+	std::vector<double> job_blocking_jd;             // Per-job direct blocking (job-driven approach)
+} sched_cache_entry_t;
+
+/* Every thread has its own cache and counters, the functions below act on the calling thread's */
+
+/**************** Set the maximum number of cached verdicts (0 disables the cache) ********************/ 
+/* Params: max_entries: bound on the number of entries of every thread's cache, the least recently used entry is evicted
+						(the other threads trim their caches on their next insert) */
+void sched_cache_set_capacity(unsigned int max_entries);
+
+/**************** Drop all cached verdicts (the counters are kept) ********************/ 
+void sched_cache_clear();
+
+/**************** Look up the verdict of a taskset mapping ********************/ 
+/* Params: task_vector: vector of tasks (ordered by priority, with core ids set)
+		   sched_mode : which schedulability test
+		   entry      : the cached verdict (populated on a hit)
+   Returns: 0 on a hit, -1 on a miss */
+int sched_cache_lookup(const std::vector<Task> &task_vector, sched_type sched_mode, sched_cache_entry_t &entry);
+
+/**************** Insert the verdict of a taskset mapping ********************/ 
+/* Params: task_vector: vector of tasks (ordered by priority, with core ids set)
+		   sched_mode : which schedulability test
+		   entry      : the verdict to cache */
+void sched_cache_insert(const std::vector<Task> &task_vector, sched_type sched_mode, const sched_cache_entry_t &entry);
+
+/**************** Get the cache counters ********************/ 
+/* Params: hits, misses, evictions: populated by this function */
+void sched_cache_get_stats(unsigned long &hits, unsigned long &misses, unsigned long &evictions);
+
+/**************** Add the counters of another thread's cache ********************/ 
+/* Params: hits, misses, evictions: counters gathered by a thread (e.g. a worker that has finished) */
+void sched_cache_add_stats(unsigned long hits, unsigned long misses, unsigned long evictions);
+
+#endif
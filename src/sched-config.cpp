@@ -0,0 +1,222 @@
+/*
+ * @file sched-config.cpp
+ * @brief Runtime configuration of the taskset generation and of the analysis
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Standard Library Imports */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <cerrno>
+
+/* Internal Headers */
+#include "sched-config.hpp"
+
+/**************** Current configuration ********************/ 
+static sched_config_t &current_sched_config()
+{
+	static sched_config_t config = []()
+	{
+		sched_config_t defaults;
+		get_default_sched_config(defaults);
+		return defaults;
+	}();
+	return config;
+}
+
+/**************** Get the default configuration ********************/ 
+void get_default_sched_config(sched_config_t &config)
+{
+	config.cpu_task_upper_bound = CPU_TASK_UPPER_BOUND;
+	config.gpu_task_upper_bound = GPU_TASK_UPPER_BOUND;
+	config.cpu_intervention_util = CPU_INTERVENTION_UTIL;
+	config.cpu_intervention_bound = CPU_INTERVENTION_BOUND;
+	config.min_period = MIN_PERIOD;
+	config.max_period = MAX_PERIOD;
+	config.hyperperiod_cap = HYPERPERIOD_CAP;
+	config.util_sampler = UTIL_SAMPLER;
+	config.gpu_fraction_granularity = GPU_FRACTION_GRANULARITY;
+	config.gpu_fraction_unit = 1.0/double(GPU_FRACTION_GRANULARITY);
+}
+
+/**************** Get the current configuration ********************/ 
+const sched_config_t &get_sched_config()
+{
+	return current_sched_config();
+}
+
+/**************** Set the current configuration ********************/ 
+int set_sched_config(const sched_config_t &config)
+{
+	const char *error = NULL;
+
+	if (!(config.cpu_task_upper_bound > 0 && config.cpu_task_upper_bound <= 1))
+		error = "cpu_task_upper_bound must be in (0, 1]";
+	else if (!(config.gpu_task_upper_bound > 0 && config.gpu_task_upper_bound <= 1))
+		error = "gpu_task_upper_bound must be in (0, 1]";
+	else if (!(config.cpu_intervention_util > 0 && config.cpu_intervention_util < 1))
+		error = "cpu_intervention_util must be in (0, 1)";
+	else if (!(config.cpu_intervention_bound > 0))
+		error = "cpu_intervention_bound must be positive";
+	else if (config.min_period < 1 || config.max_period <= config.min_period)
+		error = "the periods must satisfy 1 <= min_period < max_period";
+	else if (config.hyperperiod_cap < 1)
+		error = "hyperperiod_cap must be positive";
+	else if (config.util_sampler != UTIL_SAMPLER_UUNIFAST && config.util_sampler != UTIL_SAMPLER_RANDFIXEDSUM)
+		error = "util_sampler must be 0 (UUniFast-Discard) or 1 (RandFixedSum)";
+	else if (config.gpu_fraction_granularity < 2)
+		error = "gpu_fraction_granularity must be at least 2";
+
+	if (error != NULL)
+	{
+		std::cerr << "Config: " << error << "\n";
+		return -1;
+	}
+
+	current_sched_config() = config;
+	current_sched_config().gpu_fraction_unit = 1.0/double(config.gpu_fraction_granularity);
+	return 0;
+}
+
+/**************** Parse a number, the whole string has to be consumed ********************/ 
+static int parse_number(const std::string &text, double &value)
+{
+	char *end;
+	errno = 0;
+	value = std::strtod(text.c_str(), &end);
+	if (text.empty() || *end != '\0' || errno != 0)
+		return -1;
+	return 0;
+}
+
+/**************** Parse a configuration assignment ********************/ 
+int parse_sched_config(const std::string &assignment, sched_config_t &config)
+{
+	std::string::size_type equal = assignment.find('=');
+	std::string key, text;
+	double value;
+
+	if (equal == std::string::npos)
+	{
+		std::cerr << "Config: expected <key>=<value>, got " << assignment << "\n";
+		return -1;
+	}
+
+	// Trim the blanks around the key and the value
+	key = assignment.substr(0, equal);
+	text = assignment.substr(equal + 1);
+	key.erase(0, key.find_first_not_of(" \t"));
+	key.erase(key.find_last_not_of(" \t\r") + 1);
+	text.erase(0, text.find_first_not_of(" \t"));
+	text.erase(text.find_last_not_of(" \t\r") + 1);
+
+	if (parse_number(text, value) != 0)
+	{
+		std::cerr << "Config: malformed value of " << key << ": " << text << "\n";
+		return -1;
+	}
+
+	if (key == "cpu_task_upper_bound")
+		config.cpu_task_upper_bound = value;
+	else if (key == "gpu_task_upper_bound")
+		config.gpu_task_upper_bound = value;
+	else if (key == "cpu_intervention_util")
+		config.cpu_intervention_util = value;
+	else if (key == "cpu_intervention_bound")
+		config.cpu_intervention_bound = value;
+	else if (key == "min_period" || key == "max_period" || key == "hyperperiod_cap" || key == "gpu_fraction_granularity" ||
+			 key == "util_sampler")
+	{
+		// Integer keys
+		if (value != (double)(long long) value || value < 0)
+		{
+			std::cerr << "Config: " << key << " must be a non-negative integer, got " << text << "\n";
+			return -1;
+		}
+		if (key == "min_period")
+			config.min_period = (int) value;
+		else if (key == "max_period")
+			config.max_period = (int) value;
+		else if (key == "hyperperiod_cap")
+			config.hyperperiod_cap = (uint64_t) value;
+		else if (key == "util_sampler")
+			config.util_sampler = (int) value;
+		else
+			config.gpu_fraction_granularity = (int) value;
+	}
+	else
+	{
+		std::cerr << "Config: unknown key " << key << "\n";
+		return -1;
+	}
+	return 0;
+}
+
+/**************** Read a configuration file ********************/ 
+int load_sched_config(const std::string &filename, sched_config_t &config)
+{
+	std::ifstream infile(filename);
+	std::string line;
+	unsigned long line_number = 0;
+
+	if (!infile)
+	{
+		std::cerr << "Config: cannot read " << filename << "\n";
+		return -1;
+	}
+	while (std::getline(infile, line))
+	{
+		line_number++;
+		std::string::size_type start = line.find_first_not_of(" \t\r");
+		if (start == std::string::npos || line[start] == '#')
+			continue;
+		if (parse_sched_config(line, config) != 0)
+		{
+			std::cerr << "Config: " << filename << ":" << line_number << " is malformed\n";
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/**************** Apply a command-line configuration option ********************/ 
+int apply_sched_config(const std::string &assignment)
+{
+	sched_config_t config = get_sched_config();
+	if (parse_sched_config(assignment, config) != 0)
+		return -1;
+	return set_sched_config(config);
+}
+
+int apply_sched_config_file(const std::string &filename)
+{
+	sched_config_t config = get_sched_config();
+	if (load_sched_config(filename, config) != 0)
+		return -1;
+	return set_sched_config(config);
+}
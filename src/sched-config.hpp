@@ -0,0 +1,87 @@
+/*
+ * @file sched-config.hpp
+ * @brief Runtime configuration of the taskset generation and of the analysis
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef SCHED_CONFIG_HPP
+#define SCHED_CONFIG_HPP
+
+/* Standard Library Imports */
+#include <string>
+#include <cstdint>
+
+/* Internal Headers */
+#include "config.hpp"
+
+/* Limits of the taskset generation and of the analysis, the config.hpp values are the defaults */
+typedef struct sched_config {
+	double cpu_task_upper_bound;		// upper bound on the CPU utilization of a task
+	double gpu_task_upper_bound;		// upper bound on the GPU utilization of a segment
+	double cpu_intervention_util;		// CPU intervention of a GPU segment relative to the segment
+	double cpu_intervention_bound;		// upper bound on the CPU intervention of a GPU segment
+	int min_period;						// range of the task periods
+	int max_period;
+	uint64_t hyperperiod_cap;			// upper bound on the hyperperiod of divisor-rich periods (harmonic flag 2)
+	int util_sampler;					// sampler of the task utilizations (UTIL_SAMPLER_UUNIFAST, UTIL_SAMPLER_RANDFIXEDSUM)
+	int gpu_fraction_granularity;		// units the GPU is split into, the fractions are multiples of a unit
+	double gpu_fraction_unit;			// 1/gpu_fraction_granularity (derived by set_sched_config)
+} sched_config_t;
+
+/**************** Get the default configuration ********************/ 
+/* Params: config: populated with the config.hpp values */
+void get_default_sched_config(sched_config_t &config);
+
+/**************** Get the current configuration ********************/ 
+/* Returns: the configuration read by the generators and the tests (the defaults until set) */
+const sched_config_t &get_sched_config();
+
+/**************** Set the current configuration ********************/ 
+/* Shared by all the threads, to be set before tasksets are generated or analysed
+   Params: config: new configuration (gpu_fraction_unit is derived from the granularity)
+   Returns: 0 on success, -1 if a value is out of range (reported, the configuration is unchanged) */
+int set_sched_config(const sched_config_t &config);
+
+/**************** Parse a configuration assignment ********************/ 
+/* Params: assignment: <key>=<value>, the keys are the field names of sched_config_t (but gpu_fraction_unit)
+		   config    : updated by the function
+   Returns: 0 on success, -1 on an unknown key or a malformed value (reported) */
+int parse_sched_config(const std::string &assignment, sched_config_t &config);
+
+/**************** Read a configuration file ********************/ 
+/* One <key>=<value> per line, blank lines and lines starting with '#' are skipped
+   Params: filename: configuration file
+		   config  : updated by the function
+   Returns: 0 on success, -1 if the file cannot be read or a line is malformed (reported with its line number) */
+int load_sched_config(const std::string &filename, sched_config_t &config);
+
+/**************** Apply a command-line configuration option ********************/ 
+/* The current configuration is updated with an assignment (--config) or a file (--config-file) and set
+   Params: assignment/filename: see parse_sched_config and load_sched_config
+   Returns: 0 on success, -1 otherwise (the configuration is unchanged) */
+int apply_sched_config(const std::string &assignment);
+int apply_sched_config_file(const std::string &filename);
+
+#endif
@@ -0,0 +1,206 @@
+/*
+ * @file sim-trace.cpp
+ * @brief Chrome trace-event export of simulated schedules
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Standard Library Imports */
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/* Internal Headers */
+#include "sim-trace.hpp"
+
+// Trace processes
+#define TRACE_PID_CPU 0
+#define TRACE_PID_GPU 1
+
+// Longest event written
+#define TRACE_EVENT_LENGTH 512
+
+// Time in us, rounded as written (ns), so that adjacent slices written from the same instant do not overlap
+static double trace_time(double time)
+{
+	return nearbyint(time*1000*1000)/1000;
+}
+
+// Constructor
+SimTraceWriter::SimTraceWriter()
+{
+	first_event = true;
+	next_flow = 1;
+}
+
+// Destructor
+SimTraceWriter::~SimTraceWriter()
+{
+	close();
+}
+
+/**************** Create the trace ********************/ 
+int SimTraceWriter::open(const std::string &filename, unsigned int num_cores)
+{
+	char event[TRACE_EVENT_LENGTH];
+	int length;
+
+	outfile.open(filename, std::ios_base::trunc);
+	if (!outfile.is_open())
+	{
+		std::cerr << "Trace: cannot write " << filename << "\n";
+		return -1;
+	}
+	outfile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	first_event = true;
+	lane_busy.clear();
+
+	length = snprintf(event, sizeof(event), "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\",\"args\":{\"name\":\"CPU\"}}", TRACE_PID_CPU);
+	writeEvent(event, length);
+	length = snprintf(event, sizeof(event), "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\",\"args\":{\"name\":\"GPU\"}}", TRACE_PID_GPU);
+	writeEvent(event, length);
+	for (unsigned int core = 0; core < num_cores; core++)
+	{
+		length = snprintf(event, sizeof(event), "{\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"Core %u\"}}", 
+						  TRACE_PID_CPU, core, core);
+		writeEvent(event, length);
+	}
+	return 0;
+}
+
+/**************** Terminate the trace ********************/ 
+int SimTraceWriter::close()
+{
+	int retval;
+
+	if (!outfile.is_open())
+		return 0;
+	outfile << "\n]}\n";
+	retval = outfile.good() ? 0 : -1;
+	outfile.close();
+	return retval;
+}
+
+void SimTraceWriter::writeEvent(const char *event, int length)
+{
+	if (!first_event)
+		outfile.write(",\n", 2);
+	outfile.write(event, std::min(length, TRACE_EVENT_LENGTH - 1));
+	first_event = false;
+}
+
+uint64_t SimTraceWriter::newFlow()
+{
+	return next_flow++;
+}
+
+/**************** Execution on a core ********************/ 
+void SimTraceWriter::cpuSlice(unsigned int core, unsigned int task, double start, double end, bool boosted, 
+							  uint64_t flow_in, uint64_t flow_out)
+{
+	char event[TRACE_EVENT_LENGTH];
+	int length;
+
+	// A slice holds one flow end, the flow into a launch is never set
+	length = snprintf(event, sizeof(event), "{\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":\"T%u%s\",\"cat\":\"%s\"", 
+					  TRACE_PID_CPU, core, trace_time(start), trace_time(end) - trace_time(start), task, boosted ? " Gm" : "", boosted ? "gm" : "cpu");
+	if (flow_in != 0)
+		length += snprintf(event + length, sizeof(event) - length, ",\"bind_id\":\"0x%llx\",\"flow_in\":true", (unsigned long long) flow_in);
+	else if (flow_out != 0)
+		length += snprintf(event + length, sizeof(event) - length, ",\"bind_id\":\"0x%llx\",\"flow_out\":true", (unsigned long long) flow_out);
+	length += snprintf(event + length, sizeof(event) - length, "}");
+	writeEvent(event, length);
+}
+
+/**************** Execution on the GPU ********************/ 
+unsigned int SimTraceWriter::acquireLane()
+{
+	char event[TRACE_EVENT_LENGTH];
+	int length;
+
+	for (unsigned int lane = 0; lane < lane_busy.size(); lane++)
+	{
+		if (!lane_busy[lane])
+		{
+			lane_busy[lane] = true;
+			return lane;
+		}
+	}
+
+	// Name the track of a new lane
+	lane_busy.push_back(true);
+	length = snprintf(event, sizeof(event), "{\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"Lane %u\"}}", 
+					  TRACE_PID_GPU, (unsigned int) lane_busy.size() - 1, (unsigned int) lane_busy.size() - 1);
+	writeEvent(event, length);
+	return lane_busy.size() - 1;
+}
+
+void SimTraceWriter::gpuSlice(unsigned int lane, unsigned int task, unsigned int segment, double fraction, double start, double end,
+							  uint64_t flow_in, uint64_t flow_out)
+{
+	char event[TRACE_EVENT_LENGTH];
+	int length;
+
+	// The flow in is bound to the slice, the flow out to a zero-length step at its end
+	length = snprintf(event, sizeof(event), "{\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":\"T%u G%u\",\"cat\":\"gpu\","
+					  "\"args\":{\"F\":%g}", TRACE_PID_GPU, lane, trace_time(start), trace_time(end) - trace_time(start), task, segment, fraction);
+	if (flow_in != 0)
+		length += snprintf(event + length, sizeof(event) - length, ",\"bind_id\":\"0x%llx\",\"flow_in\":true", (unsigned long long) flow_in);
+	length += snprintf(event + length, sizeof(event) - length, "}");
+	writeEvent(event, length);
+
+	if (flow_out != 0)
+	{
+		length = snprintf(event, sizeof(event), "{\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":0,\"name\":\"T%u G%u done\",\"cat\":\"gpu\","
+						  "\"bind_id\":\"0x%llx\",\"flow_out\":true}", TRACE_PID_GPU, lane, trace_time(end), task, segment, (unsigned long long) flow_out);
+		writeEvent(event, length);
+	}
+
+	if (lane < lane_busy.size())
+		lane_busy[lane] = false;
+}
+
+void SimTraceWriter::gpuShare(double time, double share)
+{
+	char event[TRACE_EVENT_LENGTH];
+	int length;
+
+	length = snprintf(event, sizeof(event), "{\"ph\":\"C\",\"pid\":%d,\"ts\":%.3f,\"name\":\"GPU share\",\"args\":{\"F\":%g}}", 
+					  TRACE_PID_GPU, trace_time(time), share);
+	writeEvent(event, length);
+}
+
+/**************** Deadline miss ********************/ 
+void SimTraceWriter::deadlineMiss(unsigned int core, unsigned int task, double release, double time)
+{
+	char event[TRACE_EVENT_LENGTH];
+	int length;
+
+	length = snprintf(event, sizeof(event), "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"name\":\"T%u deadline miss\","
+					  "\"args\":{\"release\":%.6f,\"response\":%.6f}}", TRACE_PID_CPU, core, trace_time(time), task, release, time - release);
+	writeEvent(event, length);
+}
@@ -0,0 +1,82 @@
+/*
+ * @file sim-trace.hpp
+ * @brief Chrome trace-event export of simulated schedules
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef SIM_TRACE_HPP
+#define SIM_TRACE_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+/* Writes the trace as it is produced, only the open GPU lanes are kept, so the length of the simulation is not bounded by memory;
+   the times are in the simulator's unit (ms) and written in us. Process 0 holds a track per core, process 1 a track per GPU lane
+   (one per concurrently executing request) and the share of the GPU held; flows link the CPU intervention launching a request,
+   its GPU execution and the CPU intervention completing it */
+class SimTraceWriter
+{
+	// Constructor and destructor (the destructor closes the trace)
+	public: SimTraceWriter();
+	public: ~SimTraceWriter();
+
+	// Create the trace with a track per core, 0 on success
+	public: int open(const std::string &filename, unsigned int num_cores);
+
+	// Terminate the trace, 0 if every event was written
+	public: int close();
+
+	// Execution of a task on a core in [start, end), boosted for a CPU intervention,
+	// flow ids (0 -> none) continue a flow into the slice and out of it
+	public: void cpuSlice(unsigned int core, unsigned int task, double start, double end, bool boosted, 
+						  uint64_t flow_in, uint64_t flow_out);
+
+	// GPU execution of a request in [start, end) on a lane taken with acquireLane
+	public: unsigned int acquireLane();
+	public: void gpuSlice(unsigned int lane, unsigned int task, unsigned int segment, double fraction, double start, double end,
+						  uint64_t flow_in, uint64_t flow_out);
+
+	// Share of the GPU held from time on
+	public: void gpuShare(double time, double share);
+
+	// Job completed after its deadline
+	public: void deadlineMiss(unsigned int core, unsigned int task, double release, double time);
+
+	// Next flow id
+	public: uint64_t newFlow();
+
+	// Write an event, separated from the previous one
+	private: void writeEvent(const char *event, int length);
+
+	// Private Variables
+	private: std::ofstream outfile;
+	private: bool first_event;
+	private: std::vector<bool> lane_busy;
+	private: uint64_t next_flow;
+};
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * @file simulate_exp.cpp
+ * @brief Simulated response times of imported tasksets next to the analysis bounds
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Standard Library Imports */
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+
+/* Internal Headers */
+#include "task.hpp"
+#include "taskset-loader.hpp"
+#include "task_partitioning.hpp"
+#include "taskset-sim.hpp"
+#include "sched-config.hpp"
+#include "config.hpp"
+
+// Comparator class for ordering tasks using RMS
+struct CompareTaskPriorityRMS {
+    bool operator()(Task const & t1, Task const & t2) {
+        // return "true" if "t1" has higher RMS priority than "t2"
+        return t1.getT() < t2.getT();
+    }
+} ComparePriorityRMS;
+
+// Observed response times against the bounds, per test
+typedef struct bound_summary {
+	int admitted;					// tasksets with a feasible WFD partition (the ones simulated)
+	long jobs;
+	int exceeded;					// tasks observed above their bound
+	int deadline_misses;			// tasks with a job completed after its deadline
+	double ratio_sum;				// observed/bound over the tasks
+	double ratio_max;
+	int num_ratios;
+	double p99_ratio_sum;			// p99/bound over the tasks (random execution times)
+} bound_summary_t;
+
+int main(int argc, char **argv)
+{
+	TasksetLoader loader;
+	std::ofstream outfile;
+	int file_flag = 0;
+
+	// Random execution times (--monte-carlo <seeds>, --bcet-ratio <ratio>, --threads <threads>): the response-time
+	// percentiles over the seeds are reported next to the worst case; schedule traces (--trace <prefix>): the worst-case
+	// run of each taskset and test is written to <prefix><taskset>.<test>.json; runtime configuration (--config <key>=<value>,
+	// --config-file <file>); the positional arguments follow without them
+	std::string trace_prefix;
+	int num_seeds = 0;
+	int num_threads = 0;
+	double bcet_ratio = SIM_BCET_RATIO;
+	std::vector<char *> positional_args;
+	for (int index = 0; index < argc; index++)
+	{
+		std::string arg(argv[index]);
+		if (arg == "--monte-carlo" && index + 1 < argc)
+			num_seeds = std::atoi(argv[++index]);
+		else if (arg == "--bcet-ratio" && index + 1 < argc)
+			bcet_ratio = std::atof(argv[++index]);
+		else if (arg == "--threads" && index + 1 < argc)
+			num_threads = std::atoi(argv[++index]);
+		else if (arg == "--trace" && index + 1 < argc)
+			trace_prefix = argv[++index];
+		else if (arg == "--config" && index + 1 < argc)
+		{
+			if (apply_sched_config(argv[++index]) != 0)
+				exit(1);
+		}
+		else if (arg == "--config-file" && index + 1 < argc)
+		{
+			if (apply_sched_config_file(argv[++index]) != 0)
+				exit(1);
+		}
+		else
+			positional_args.push_back(argv[index]);
+	}
+	argc = positional_args.size();
+	argv = positional_args.data();
+
+	if (argc < 2)
+	{
+		std::cout << "Usage: " << argv[0] << " <taskset file> [output file] [number of cores] [horizon]"
+				  << " [--monte-carlo <seeds>] [--bcet-ratio <ratio>] [--threads <threads>] [--trace <prefix>]"
+				  << " [--config <key>=<value>] [--config-file <file>]\n";
+		exit(1);
+	}
+
+	// Taskset description
+	if (loader.open(argv[1]) != 0)
+		exit(1);
+
+	// Output filename (one line per simulated task: name,test,task,core,T,D,bound,observed[,p50,p99,p999])
+	if (argc > 2 && std::string(argv[2]) != "-")
+	{
+		file_flag = 1;
+		outfile.open(argv[2], std::ios_base::trunc);
+	}
+
+	// Number of Cores
+	int num_cores = 4;
+	if (argc > 3)
+		num_cores = std::atoi(argv[3]);
+
+	// Simulated time (0 -> hyperperiod)
+	double horizon = 0;
+	if (argc > 4)
+		horizon = std::atof(argv[4]);
+
+	std::vector<Task> task_vector;
+	std::vector<Task> mapped_tasks;
+	std::string name;
+	std::vector<double> resp_time_rd, resp_time_jd, job_blocking_jd, bound;
+	std::vector<std::vector<double>> req_blocking_rd;
+	sim_params_t params;
+	sim_stats_t stats;
+	sim_distribution_t distribution;
+	bound_summary_t summary[INVALID] = {};
+	double sim_time = 0;
+	long total_jobs = 0, total_events = 0;
+	long num_tasksets = 0;
+	int retval;
+
+	while ((retval = loader.next(task_vector, name)) == 1)
+	{
+		num_tasksets++;
+		std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+
+		for (int test = 0; test < INVALID; test++)
+		{
+			mapped_tasks = task_vector;
+			resp_time_rd.clear();
+			req_blocking_rd.clear();
+			resp_time_jd.clear();
+			job_blocking_jd.clear();
+			if (worst_fit_decreasing(mapped_tasks, num_cores, (sched_type) test, resp_time_rd, resp_time_jd, 
+									 req_blocking_rd, job_blocking_jd, ComparePriorityRMS) != 0)
+				continue;
+
+			// Bounds of the mapping, in priority order as the simulator takes it
+			std::sort(mapped_tasks.begin(), mapped_tasks.end(), ComparePriorityRMS);
+			get_partition_response_times(mapped_tasks, (sched_type) test, bound);
+
+			get_sim_params((sched_type) test, params);
+			params.horizon = horizon;
+			auto start = std::chrono::steady_clock::now();
+			if (trace_prefix.empty())
+				simulate_taskset(mapped_tasks, params, stats);
+			else if (simulate_taskset_trace(mapped_tasks, params, stats, trace_prefix + name + "." + std::to_string(test) + ".json") != 0)
+				exit(1);
+			sim_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			total_jobs += stats.total_jobs;
+			total_events += stats.num_events;
+
+			// Same releases with random execution times
+			if (num_seeds > 0)
+			{
+				params.exec_model = SIM_EXEC_UNIFORM;
+				params.bcet_ratio = bcet_ratio;
+				params.seed = num_tasksets*INVALID + test;
+				simulate_taskset_monte_carlo(mapped_tasks, params, num_seeds, num_threads, distribution);
+			}
+
+			summary[test].admitted++;
+			summary[test].jobs += stats.total_jobs;
+			for (unsigned int index = 0; index < mapped_tasks.size(); index++)
+			{
+				if (stats.max_resp_time[index] > bound[index] + EPSILON_FLO)
+					summary[test].exceeded++;
+				if (stats.deadline_misses[index] > 0)
+					summary[test].deadline_misses++;
+				if (bound[index] > 0)
+				{
+					summary[test].ratio_sum += stats.max_resp_time[index]/bound[index];
+					summary[test].ratio_max = std::max(summary[test].ratio_max, stats.max_resp_time[index]/bound[index]);
+					summary[test].num_ratios++;
+					if (num_seeds > 0)
+						summary[test].p99_ratio_sum += distribution.p99[index]/bound[index];
+				}
+				if (file_flag == 1)
+				{
+					outfile << name << "," << test << "," << index << "," << mapped_tasks[index].getCoreID() << ","
+							<< mapped_tasks[index].getT() << "," << mapped_tasks[index].getD() << ","
+							<< bound[index] << "," << stats.max_resp_time[index];
+					if (num_seeds > 0)
+						outfile << "," << distribution.p50[index] << "," << distribution.p99[index] << "," << distribution.p999[index];
+					outfile << "\n";
+				}
+			}
+		}
+	}
+
+	if (file_flag == 1)
+		outfile.close();
+
+	std::cout << "Tasksets: " << num_tasksets << "\n";
+	std::cout << "Simulated Jobs/Events: " << total_jobs << "/" << total_events << "\n";
+	if (sim_time > 0)
+		std::cout << "Simulation Throughput (jobs/s): " << total_jobs/sim_time << "\n";
+
+	std::cout << "Observed vs Bound (admitted, tasks above bound, tasks missing a deadline, mean/max observed/bound"
+			  << (num_seeds > 0 ? ", mean p99/bound)\n" : ")\n");
+	for (int test = 0; test < INVALID; test++)
+	{
+		std::cout << get_sched_type_label(test) << ": " << summary[test].admitted << ", " << summary[test].exceeded << ", " 
+				  << summary[test].deadline_misses << ", "
+				  << (summary[test].num_ratios ? summary[test].ratio_sum/summary[test].num_ratios : 0) << "/" 
+				  << summary[test].ratio_max;
+		if (num_seeds > 0)
+			std::cout << ", " << (summary[test].num_ratios ? summary[test].p99_ratio_sum/summary[test].num_ratios : 0);
+		std::cout << "\n";
+	}
+
+	// The tasksets before the malformed line were simulated
+	if (retval < 0)
+		return 1;
+	return 0;
+}
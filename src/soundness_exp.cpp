@@ -0,0 +1,502 @@
+/*
+ * @file soundness_exp.cpp
+ * @brief Differential soundness check of the analysis bounds against the simulator, with shrinking
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Standard Library Imports */
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+/* Internal Headers */
+#include "task.hpp"
+#include "taskset-gen.hpp"
+#include "task_partitioning.hpp"
+#include "taskset-sim.hpp"
+#include "sched-config.hpp"
+#include "config.hpp"
+
+// Comparator class for ordering tasks using RMS
+struct CompareTaskPriorityRMS {
+    bool operator()(Task const & t1, Task const & t2) {
+        // return "true" if "t1" has higher RMS priority than "t2"
+        return t1.getT() < t2.getT();
+    }
+} ComparePriorityRMS;
+
+// Simulation of a candidate taskset
+typedef struct soundness_params {
+	double horizon;					// simulated time (0 -> hyperperiod)
+	int num_seeds;					// simulations with random execution times on top of the WCET one
+	double bcet_ratio;
+	unsigned int seed;				// first seed of the random execution times
+} soundness_params_t;
+
+// Task observed above its bound
+typedef struct violation {
+	unsigned int task;				// in the priority order of the mapping
+	unsigned int core;
+	double bound;
+	double observed;
+} violation_t;
+
+// Violations of the bounds, per test
+typedef struct soundness_summary {
+	long admitted;					// tasksets with a feasible WFD partition (the ones simulated)
+	long violations;				// admitted tasksets with a task observed above its bound
+	int reproducers;				// violations shrunk to a reproducer
+} soundness_summary_t;
+
+/**************** Get the parameters of a task ********************/ 
+static task_t get_task_params(const Task &task)
+{
+	task_t task_params;
+	task_params.C = task.getC();
+	task_params.D = task.getD();
+	task_params.T = task.getT();
+	for (unsigned int i = 0; i < task.getNumGPUSegments(); i++)
+	{
+		gpu_params_t segment = {task.getGm(i), task.getGe(i), task.getF(i)};
+		task_params.G.push_back(segment);
+	}
+	return task_params;
+}
+
+/**************** Build a taskset in RMS priority order ********************/ 
+static void build_taskset(const std::vector<task_t> &taskset_params, std::vector<Task> &task_vector)
+{
+	task_vector.clear();
+	for (unsigned int index = 0; index < taskset_params.size(); index++)
+		task_vector.push_back(Task(taskset_params[index]));
+	std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+}
+
+/**************** Check the bounds of a test against the simulated response times ********************/ 
+/* Params: task_vector: taskset in priority order (not mapped)
+		   test       : schedulability test, the taskset is mapped by WFD with it
+		   num_cores  : number of cores
+		   params     : simulation parameters
+		   violation  : task furthest above its bound (populated by the function)
+   Returns: 1 if a task is observed above its bound, 0 if none is, -1 if the test rejects the taskset */
+static int find_violation(const std::vector<Task> &task_vector, sched_type test, int num_cores, const soundness_params_t &params,
+						  violation_t &violation)
+{
+	std::vector<Task> mapped_tasks = task_vector;
+	std::vector<double> resp_time_rd, resp_time_jd, job_blocking_jd, bound;
+	std::vector<std::vector<double>> req_blocking_rd;
+	sim_params_t sim_params;
+	sim_stats_t stats;
+	sim_distribution_t distribution;
+
+	if (worst_fit_decreasing(mapped_tasks, num_cores, test, resp_time_rd, resp_time_jd, req_blocking_rd, job_blocking_jd, 
+							 ComparePriorityRMS) != 0)
+		return -1;
+
+	// Bounds of the mapping, in priority order as the simulator takes it
+	std::sort(mapped_tasks.begin(), mapped_tasks.end(), ComparePriorityRMS);
+	get_partition_response_times(mapped_tasks, test, bound);
+
+	get_sim_params(test, sim_params);
+	sim_params.horizon = params.horizon;
+	if (simulate_taskset(mapped_tasks, sim_params, stats) != 0)
+		return 0;
+	std::vector<double> observed = stats.max_resp_time;
+
+	// Shorter executions can lengthen the response times of others (scheduling anomalies)
+	if (params.num_seeds > 0)
+	{
+		sim_params.exec_model = SIM_EXEC_UNIFORM;
+		sim_params.bcet_ratio = params.bcet_ratio;
+		sim_params.seed = params.seed;
+		if (simulate_taskset_monte_carlo(mapped_tasks, sim_params, params.num_seeds, 1, distribution) == 0)
+			for (unsigned int index = 0; index < observed.size(); index++)
+				observed[index] = std::max(observed[index], distribution.max_resp_time[index]);
+	}
+
+	int found = 0;
+	for (unsigned int index = 0; index < mapped_tasks.size(); index++)
+	{
+		if (observed[index] <= bound[index] + EPSILON_FLO)
+			continue;
+		if (found == 0 || observed[index] - bound[index] > violation.observed - violation.bound)
+		{
+			violation.task = index;
+			violation.core = mapped_tasks[index].getCoreID();
+			violation.bound = bound[index];
+			violation.observed = observed[index];
+		}
+		found = 1;
+	}
+	return found;
+}
+
+/**************** Simplified value of a task parameter ********************/ 
+/* Rounded to one significant digit, else to two, else halved (down to 0.01)
+   Returns: 1 if a simpler value exists */
+static int simplify_value(double value, double &simpler)
+{
+	if (value <= 0)
+		return 0;
+	for (int digits = 1; digits <= 2; digits++)
+	{
+		double scale = std::pow(10, digits - 1 - std::floor(std::log10(value)));
+		simpler = std::round(value*scale)/scale;
+		if (std::fabs(simpler - value) > 1e-12*value)
+			return 1;
+	}
+	simpler = value/2;
+	return (simpler >= 0.01) ? 1 : 0;
+}
+
+/**************** Shrink a violating taskset ********************/ 
+/* Greedy reduction, a change is kept when the test still admits the taskset and a task is still observed above its bound:
+   fewer cores, tasks removed, GPU segments removed, D set to T, then C, Gm and Ge simplified, repeated until no change
+   is kept or SOUNDNESS_MAX_SHRINK_STEPS candidates have been tried
+   Params: taskset_params: violating taskset (shrunk by the function)
+		   test, params  : see find_violation
+		   num_cores     : number of cores (reduced by the function)
+		   violation     : violation of the shrunk taskset (populated by the function)
+   Returns: number of candidates tried */
+static int shrink_violation(std::vector<task_t> &taskset_params, sched_type test, int &num_cores, const soundness_params_t &params,
+							violation_t &violation)
+{
+	std::vector<task_t> candidate;
+	std::vector<Task> task_vector;
+	violation_t candidate_violation;
+	int num_steps = 0;
+	bool progress = true;
+
+	auto try_candidate = [&](int candidate_cores) -> bool
+	{
+		num_steps++;
+		build_taskset(candidate, task_vector);
+		if (find_violation(task_vector, test, candidate_cores, params, candidate_violation) != 1)
+			return false;
+		taskset_params = candidate;
+		num_cores = candidate_cores;
+		violation = candidate_violation;
+		return true;
+	};
+
+	while (progress && num_steps < SOUNDNESS_MAX_SHRINK_STEPS)
+	{
+		progress = false;
+
+		// Fewer cores
+		for (int cores = 1; cores < num_cores && num_steps < SOUNDNESS_MAX_SHRINK_STEPS; cores++)
+		{
+			candidate = taskset_params;
+			if (try_candidate(cores))
+			{
+				progress = true;
+				break;
+			}
+		}
+
+		// Tasks removed
+		for (unsigned int index = taskset_params.size(); index-- > 0 && taskset_params.size() > 1 && num_steps < SOUNDNESS_MAX_SHRINK_STEPS;)
+		{
+			candidate = taskset_params;
+			candidate.erase(candidate.begin() + index);
+			if (try_candidate(num_cores))
+				progress = true;
+		}
+
+		// GPU segments removed
+		for (unsigned int index = 0; index < taskset_params.size(); index++)
+		{
+			for (unsigned int i = taskset_params[index].G.size(); i-- > 0 && num_steps < SOUNDNESS_MAX_SHRINK_STEPS;)
+			{
+				candidate = taskset_params;
+				candidate[index].G.erase(candidate[index].G.begin() + i);
+				if (try_candidate(num_cores))
+					progress = true;
+			}
+		}
+
+		// Implicit deadlines and simpler execution times
+		for (unsigned int index = 0; index < taskset_params.size() && num_steps < SOUNDNESS_MAX_SHRINK_STEPS; index++)
+		{
+			double simpler;
+			if (taskset_params[index].D != taskset_params[index].T)
+			{
+				candidate = taskset_params;
+				candidate[index].D = candidate[index].T;
+				if (try_candidate(num_cores))
+					progress = true;
+			}
+			if (simplify_value(taskset_params[index].C, simpler) == 1)
+			{
+				candidate = taskset_params;
+				candidate[index].C = simpler;
+				if (try_candidate(num_cores))
+					progress = true;
+			}
+			for (unsigned int i = 0; i < taskset_params[index].G.size() && num_steps < SOUNDNESS_MAX_SHRINK_STEPS; i++)
+			{
+				if (simplify_value(taskset_params[index].G[i].Gm, simpler) == 1)
+				{
+					candidate = taskset_params;
+					candidate[index].G[i].Gm = simpler;
+					if (try_candidate(num_cores))
+						progress = true;
+				}
+				if (simplify_value(taskset_params[index].G[i].Ge, simpler) == 1)
+				{
+					candidate = taskset_params;
+					candidate[index].G[i].Ge = simpler;
+					if (try_candidate(num_cores))
+						progress = true;
+				}
+			}
+		}
+	}
+	return num_steps;
+}
+
+/**************** Write a reproducer in the taskset description format ********************/ 
+/* The violation is described by comment lines, the taskset replays with simulate_exp on the same number of cores */
+static void write_reproducer(std::ostream &out, const std::string &name, sched_type test, int num_cores, long taskset_index,
+							 const std::vector<task_t> &taskset_params, const violation_t &violation)
+{
+	out << "# " << name << ": test " << test << " (" << sched_type_names[test] << "), " << num_cores << " cores, taskset "
+		<< taskset_index << ", task " << violation.task << " on core " << violation.core << " observed " << violation.observed 
+		<< " above its bound " << violation.bound << "\n";
+	out << std::setprecision(17);
+	for (unsigned int index = 0; index < taskset_params.size(); index++)
+	{
+		out << name << "," << taskset_params[index].C << "," << taskset_params[index].D << "," << taskset_params[index].T;
+		for (unsigned int i = 0; i < taskset_params[index].G.size(); i++)
+			out << "," << taskset_params[index].G[i].Gm << "," << taskset_params[index].G[i].Ge << "," << taskset_params[index].G[i].F;
+		out << "\n";
+	}
+	out << std::setprecision(6);
+}
+
+int main(int argc, char **argv)
+{
+	std::ofstream outfile;
+	int file_flag = 0;
+
+	// Base seed of the taskset streams (--seed <seed>), simulated time (--horizon <time>), random execution times
+	// (--monte-carlo <seeds>, --bcet-ratio <ratio>), violations shrunk per test (--reproducers <count>), a single
+	// test (--test <sched type>) and the runtime configuration (--config <key>=<value>, --config-file <file>); the
+	// positional arguments follow without them
+	unsigned int base_seed = 1;
+	int max_reproducers = SOUNDNESS_REPRODUCERS_PER_TEST;
+	int only_test = -1;
+	soundness_params_t params;
+	params.horizon = 0;
+	params.num_seeds = 0;
+	params.bcet_ratio = SIM_BCET_RATIO;
+	params.seed = 0;
+	std::vector<char *> positional_args;
+	for (int index = 0; index < argc; index++)
+	{
+		std::string arg(argv[index]);
+		if (arg == "--seed" && index + 1 < argc)
+			base_seed = std::strtoul(argv[++index], NULL, 10);
+		else if (arg == "--horizon" && index + 1 < argc)
+			params.horizon = std::atof(argv[++index]);
+		else if (arg == "--monte-carlo" && index + 1 < argc)
+			params.num_seeds = std::atoi(argv[++index]);
+		else if (arg == "--bcet-ratio" && index + 1 < argc)
+			params.bcet_ratio = std::atof(argv[++index]);
+		else if (arg == "--reproducers" && index + 1 < argc)
+			max_reproducers = std::atoi(argv[++index]);
+		else if (arg == "--test" && index + 1 < argc)
+			only_test = std::atoi(argv[++index]);
+		else if (arg == "--config" && index + 1 < argc)
+		{
+			if (apply_sched_config(argv[++index]) != 0)
+				exit(1);
+		}
+		else if (arg == "--config-file" && index + 1 < argc)
+		{
+			if (apply_sched_config_file(argv[++index]) != 0)
+				exit(1);
+		}
+		else
+			positional_args.push_back(argv[index]);
+	}
+	argc = positional_args.size();
+	argv = positional_args.data();
+
+	if (argc < 2 || only_test >= INVALID)
+	{
+		std::cout << "Usage: " << argv[0] << " <time budget (s)> [reproducer file] [number of cores] [threads]"
+				  << " [--seed <seed>] [--horizon <time>] [--monte-carlo <seeds>] [--bcet-ratio <ratio>]"
+				  << " [--reproducers <count>] [--test <sched type>] [--config <key>=<value>] [--config-file <file>]\n";
+		exit(1);
+	}
+
+	// Time budget
+	double time_budget = std::atof(argv[1]);
+
+	// Reproducer filename (the shrunk violating tasksets, in the taskset description format)
+	if (argc > 2 && std::string(argv[2]) != "-")
+	{
+		file_flag = 1;
+		outfile.open(argv[2], std::ios_base::trunc);
+		if (!outfile)
+		{
+			std::cerr << "Soundness: cannot write " << argv[2] << "\n";
+			exit(1);
+		}
+	}
+
+	// Number of Cores
+	int num_cores = 4;
+	if (argc > 3)
+		num_cores = std::atoi(argv[3]);
+
+	// Number of threads (0 = one per hardware thread)
+	int num_threads = 0;
+	if (argc > 4)
+		num_threads = std::atoi(argv[4]);
+	if (num_threads <= 0)
+		num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+	soundness_summary_t summary[INVALID] = {};
+	std::atomic<long> taskset_claims(0);
+	std::atomic<long> num_tasksets(0);
+	std::atomic<long> num_simulations(0);
+	std::mutex summary_lock;
+	std::vector<std::thread> threads;
+
+	auto start = std::chrono::steady_clock::now();
+	auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(time_budget));
+
+	for (int t = 0; t < num_threads; t++)
+	{
+		threads.emplace_back([&]()
+		{
+			std::vector<Task> task_vector;
+			taskset_arena_t arena;
+			std::vector<task_t> taskset_params;
+			violation_t violation;
+
+			while (std::chrono::steady_clock::now() < deadline)
+			{
+				// Taskset i is the same for a base seed whatever the thread drawing it
+				long taskset_index = taskset_claims++;
+				seed_taskset_stream(base_seed, taskset_index);
+
+				int number_tasks = 2 + taskset_rand() % (MAX_TASKS - 1);
+				int number_gpu_tasks = ceil(FRACTION_TASKS_GPU*number_tasks);
+				double utilization = (0.05 + 0.75*taskset_rand()/RAND_MAX)*num_cores;
+				double gpu_utilization = 0.05 + 0.75*taskset_rand()/RAND_MAX;
+				if (generate_tasks_in_place(arena, task_vector, number_tasks, number_gpu_tasks, MAX_GPU_SEGMENTS, utilization, 
+											gpu_utilization, 2, 1, MAX_GPU_FRACTION) != 0)
+					continue;
+				std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+				num_tasksets++;
+
+				for (int test = 0; test < INVALID; test++)
+				{
+					if (only_test >= 0 && test != only_test)
+						continue;
+
+					int found = find_violation(task_vector, (sched_type) test, num_cores, params, violation);
+					if (found < 0)
+						continue;
+					num_simulations++;
+
+					bool shrink = false;
+					{
+						std::lock_guard<std::mutex> guard(summary_lock);
+						summary[test].admitted++;
+						if (found == 1)
+						{
+							summary[test].violations++;
+							if (summary[test].reproducers < max_reproducers)
+							{
+								summary[test].reproducers++;
+								shrink = true;
+							}
+						}
+					}
+					if (!shrink)
+						continue;
+
+					// Minimal reproducer, written as soon as it is shrunk
+					taskset_params.clear();
+					for (unsigned int index = 0; index < task_vector.size(); index++)
+						taskset_params.push_back(get_task_params(task_vector[index]));
+					int shrunk_cores = num_cores;
+					int num_steps = shrink_violation(taskset_params, (sched_type) test, shrunk_cores, params, violation);
+
+					std::ostringstream name;
+					name << "t" << test << "_" << taskset_index;
+					std::lock_guard<std::mutex> guard(summary_lock);
+					std::cout << get_sched_type_label(test) << ": taskset " << taskset_index << " shrunk to " << taskset_params.size() 
+							  << " tasks on " << shrunk_cores << " cores (" << num_steps << " candidates), task " << violation.task 
+							  << " observed " << violation.observed << " above its bound " << violation.bound << "\n";
+					if (file_flag == 1)
+					{
+						write_reproducer(outfile, name.str(), (sched_type) test, shrunk_cores, taskset_index, taskset_params, violation);
+						outfile.flush();
+					}
+				}
+			}
+		});
+	}
+
+	for (unsigned int t = 0; t < threads.size(); t++)
+		threads[t].join();
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (file_flag == 1)
+		outfile.close();
+
+	long total_violations = 0;
+	std::cout << "Tasksets/Simulated Partitions: " << num_tasksets << "/" << num_simulations << " in " << elapsed << " s on " 
+			  << num_threads << " threads\n";
+	std::cout << "Bounds vs Simulation (admitted, violating tasksets, reproducers)\n";
+	for (int test = 0; test < INVALID; test++)
+	{
+		if (only_test >= 0 && test != only_test)
+			continue;
+		std::cout << get_sched_type_label(test) << ": " << summary[test].admitted << ", " << summary[test].violations << ", " 
+				  << summary[test].reproducers << "\n";
+		total_violations += summary[test].violations;
+	}
+
+	// A bound below an observed response time fails the run
+	if (total_violations > 0)
+		return 1;
+	return 0;
+}
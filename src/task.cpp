@@ -33,12 +33,24 @@
 // Constructor
 Task::Task(task_t task_params)
 {
-	params = task_params;
+	setParams(task_params);
+}
+
+// Reset the task -> the vectors keep their capacity
+void Task::setParams(const task_t &task_params)
+{
+	params.C = task_params.C;
+	params.D = task_params.D;
+	params.T = task_params.T;
+	params.G.assign(task_params.G.begin(), task_params.G.end());
 	num_gpu_segments = task_params.G.size();
 	cpu_freq = 1.0;
 	gpu_freq = 1.0;
 	core_id = 0;
-	gpu_seg_response_time.resize(num_gpu_segments, 0);
+	split = SPLIT_NONE;
+	split_id = 0;
+	release_jitter = 0;
+	gpu_seg_response_time.assign(num_gpu_segments, 0);
 }
 
 // Destructor
@@ -235,7 +247,7 @@ unsigned int Task::getNumGPUSegments() const
 
 double Task::getD() const 
 {
-	return params.D;
+	return params.D - release_jitter;
 }
 
 double Task::getT() const 
@@ -263,6 +275,50 @@ int Task::setCoreID(unsigned int coreID)
 	core_id = coreID;
 }
 
+Task Task::splitTask(double head_C, unsigned int id)
+{
+	task_t tail_params;
+
+	// The tail only executes on the CPU
+	tail_params.C = params.C - head_C;
+	tail_params.D = params.D;
+	tail_params.T = params.T;
+
+	Task tail(tail_params);
+	tail.cpu_freq = cpu_freq;
+	tail.gpu_freq = gpu_freq;
+	tail.split = SPLIT_TAIL;
+	tail.split_id = id;
+
+	params.C = head_C;
+	split = SPLIT_HEAD;
+	split_id = id;
+	return tail;
+}
+
+int Task::getSplitPart() const
+{
+	return split;
+}
+
+unsigned int Task::getSplitID() const
+{
+	return split_id;
+}
+
+double Task::getJ() const
+{
+	return release_jitter;
+}
+
+int Task::setJ(double J)
+{
+	if (split != SPLIT_TAIL || J < 0)
+		return -1;
+	release_jitter = J;
+	return 0;
+}
+
 int Task::scale_cpu(double cpu_frequency)
 {
 	if (cpu_frequency > 1)
@@ -43,17 +43,46 @@ typedef struct task {
 	double T;						  // Period
 } task_t;
 
+/* Part of a task split across two cores (semi-partitioning) */
+enum split_part
+{
+	SPLIT_NONE 	= 0,
+	SPLIT_HEAD 	= 1,	// first part of the CPU budget, with all the GPU segments
+	SPLIT_TAIL 	= 2		// rest of the CPU budget, released when the head completes
+};
+
 class Task
 {
 	// Constructor and destructor
 	public: Task(task_t task_params);
 	public: ~Task();
 
+	// Copy and move (declared, as the destructor would suppress the implicit moves)
+	public: Task(const Task &task) = default;
+	public: Task(Task &&task) = default;
+	public: Task &operator=(const Task &task) = default;
+	public: Task &operator=(Task &&task) = default;
+
+	// Reset the task to new parameters as the constructor does, reusing its storage
+	public: void setParams(const task_t &task_params);
+
 	// Get the task parameters
+	// -> the deadline is relative to the release of this part, so the tail of a split task sees D - J
 	public: double getC() const; 
 	public: double getD() const; 
 	public: double getT() const;
 
+	// Split the CPU budget, this task keeps head_C (and the GPU segments) and the tail is returned
+	public: Task splitTask(double head_C, unsigned int split_id);
+
+	// Get the split part and the id shared by the head and the tail
+	public: int getSplitPart() const;
+	public: unsigned int getSplitID() const;
+
+	// Get/Set the release jitter (response time of the head for a tail, 0 otherwise)
+	public: double getJ() const;
+	public: int setJ(double J);
+
 	// Get the GPU Exec Parameters (i -> segment number, starting at 0)
 	public: double getGm(unsigned int i) const; 
 	public: double getGe(unsigned int i) const; 
@@ -106,6 +135,9 @@ class Task
 	private: double cpu_freq;
 	private: double gpu_freq;
 	private: int core_id; 
+	private: int split;
+	private: unsigned int split_id;
+	private: double release_jitter;
 	private: std::vector<double> gpu_seg_response_time;  // WCRT of the GPU segments
 };
 
@@ -31,10 +31,19 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <limits>
 
 /* Internal Headers */
 #include "task_partitioning.hpp"
+#include "sched-cache.hpp"
+#include "core-heap.hpp"
 #include "taskset.hpp"
+#include "taskset-gen.hpp"
+#include "config.hpp"
 
 /* Schedulability test headers */
 #include "request-driven-test.hpp"
@@ -44,6 +53,23 @@
 #include "job-driven-test-conc.hpp"
 #include "hybrid-test-conc.hpp"
 #include "fifo-test-conc.hpp"
+#include "indirect-cis.hpp"
+
+// Names of the schedulability tests, indexed by sched_type
+const char *sched_type_names[INVALID] = {"Request-Driven", "Job-Driven", "Hybrid", "Request-Driven-Conc-S", "Job-Driven-Conc",
+										 "Request-Driven-Conc", "Job-Driven-Conc-RO", "Hybrid-Conc", "FIFO-Conc"};
+
+// Short keys of the schedulability tests, indexed by sched_type
+const char *sched_type_keys[INVALID] = {"rd", "jd", "hybrid", "rdc_simple", "jdc", "rdc", "jdc_ro", "hybrid_conc", "fifo_conc"};
+
+/**************** Name of a schedulability test, padded for the drivers' tables ********************/ 
+std::string get_sched_type_label(int test)
+{
+	std::string label(sched_type_names[test]);
+	if (label.size() < SCHED_TYPE_LABEL_WIDTH)
+		label.resize(SCHED_TYPE_LABEL_WIDTH, ' ');
+	return label;
+}
 
 // Comparator class for ordering tasks in decreasing order of utilization
 struct CompareTaskUtil {
@@ -70,33 +96,13 @@ unsigned int find_minutil_core(std::vector<double> &core_util, unsigned int star
 	return min_index;
 }
 
-/**************** Find the core with the minimum utilization excluding certain cores ********************/ 
-unsigned int find_minutil_core_excluding(std::vector<double> &core_util, unsigned int start_core, std::vector<unsigned int> &exclusion_list)
-{
-	unsigned int min_index = 0;
-	double min_util = 2.0;
-
-	for (unsigned int index = start_core; index < core_util.size(); index++)
-	{
-		// Continue if the  index is in the exclusion list
-		if(std::find(exclusion_list.begin(), exclusion_list.end(), index) != exclusion_list.end())
-			continue;
-
-		if(core_util[index] < min_util)
-		{
-			min_util = core_util[index];
-			min_index = index;
-		}
-	}
-	return min_index;
-}
-
-/**************** Utility function to check schedulability ********************/ 
-static int check_schedulability(std::vector<Task> &task_vector, sched_type sched_mode,
+/**************** Utility function to run a schedulability test ********************/ 
+static int run_schedulability_test(std::vector<Task> &task_vector, sched_type sched_mode,
 			 			std::vector<double> &resp_time_rd,
 						std::vector<double> &resp_time_jd,
 						std::vector<std::vector<double>> &req_blocking_rd,
-						std::vector<double> &job_blocking_jd)
+						std::vector<double> &job_blocking_jd,
+						std::vector<double> &resp_time)
 {
 	int sched_flag = -1;
 	// Check Schedulability
@@ -105,10 +111,12 @@ static int check_schedulability(std::vector<Task> &task_vector, sched_type sched
 		// Check Schedulability -> Non-concurrent approaches
 		case REQUEST_DRIVEN:
 			sched_flag = check_schedulability_request_driven(task_vector, resp_time_rd, req_blocking_rd);
+			resp_time = resp_time_rd;
 			break;
 
 		case JOB_DRIVEN:
 			sched_flag = check_schedulability_job_driven(task_vector, resp_time_jd);
+			resp_time = resp_time_jd;
 			break;
 			
 		case HYBRID:
@@ -117,25 +125,29 @@ static int check_schedulability(std::vector<Task> &task_vector, sched_type sched
 			resp_time_jd.clear();
 			check_schedulability_request_driven(task_vector, resp_time_rd, req_blocking_rd);
 			check_schedulability_job_driven(task_vector, resp_time_jd);
-			sched_flag = check_schedulability_hybrid(task_vector, resp_time_rd, resp_time_jd, req_blocking_rd);
+			sched_flag = check_schedulability_hybrid(task_vector, resp_time_rd, resp_time_jd, req_blocking_rd, resp_time);
 			break;
 			
 		// Check Schedulability -> Concurrent approaches (simple)
 		case REQUEST_DRIVEN_CONC_SIMPLE:	
 			sched_flag = check_schedulability_request_driven_conc(task_vector, resp_time_rd, req_blocking_rd, true);
+			resp_time = resp_time_rd;
 			break;
 
 		case JOB_DRIVEN_CONC:
 			sched_flag = check_schedulability_job_driven_conc(task_vector, resp_time_jd, job_blocking_jd, false);
+			resp_time = resp_time_jd;
 			break;
 			
 		// Check Schedulability -> Concurrent approaches (complex)
 		case REQUEST_DRIVEN_CONC: 	
 			sched_flag = check_schedulability_request_driven_conc(task_vector, resp_time_rd, req_blocking_rd, false);
+			resp_time = resp_time_rd;
 			break;
 
 		case JOB_DRIVEN_CONC_RO:
 			sched_flag = check_schedulability_job_driven_conc(task_vector, resp_time_jd, job_blocking_jd, true);
+			resp_time = resp_time_jd;
 			break;
 
 		case HYBRID_CONC:
@@ -145,11 +157,11 @@ static int check_schedulability(std::vector<Task> &task_vector, sched_type sched
 			job_blocking_jd.clear();
 			check_schedulability_request_driven_conc(task_vector, resp_time_rd, req_blocking_rd, false);
 			check_schedulability_job_driven_conc(task_vector, resp_time_jd, job_blocking_jd, true);
-			sched_flag = check_schedulability_hybrid_conc(task_vector, resp_time_rd, resp_time_jd, req_blocking_rd, job_blocking_jd);
+			sched_flag = check_schedulability_hybrid_conc(task_vector, resp_time_rd, resp_time_jd, req_blocking_rd, job_blocking_jd, resp_time);
 			break;
 
 		case FIFO_CONC:
-			sched_flag = check_schedulability_fifo_conc(task_vector);
+			sched_flag = check_schedulability_fifo_conc(task_vector, resp_time);
 			break;
 
 		default:
@@ -158,27 +170,139 @@ static int check_schedulability(std::vector<Task> &task_vector, sched_type sched
 	return sched_flag;
 }
 
-/**************** The WFD Partitioning Algorithm ********************/ 
-int worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
-						 std::vector<double> &resp_time_rd,
-						 std::vector<double> &resp_time_jd,
-						 std::vector<std::vector<double>> &req_blocking_rd,
-						 std::vector<double> &job_blocking_jd,
-						 std::function<bool(Task const &, Task const &)> priority_ordering)
+/**************** Utility function to check schedulability, consulting the verdict cache ********************/ 
+static int check_schedulability_cached(std::vector<Task> &task_vector, sched_type sched_mode,
+			 			std::vector<double> &resp_time_rd,
+						std::vector<double> &resp_time_jd,
+						std::vector<std::vector<double>> &req_blocking_rd,
+						std::vector<double> &job_blocking_jd,
+						std::vector<double> &resp_time)
+{
+	sched_cache_entry_t entry;
+
+	if (sched_cache_lookup(task_vector, sched_mode, entry) == 0)
+	{
+		// Leave the GPU segment response times set, as the test would have
+		pre_compute_gpu_response_time(task_vector);
+		resp_time = entry.resp_time;
+		resp_time_rd = entry.resp_time_rd;
+		resp_time_jd = entry.resp_time_jd;
+		req_blocking_rd = entry.req_blocking_rd;
+		job_blocking_jd = entry.job_blocking_jd;
+		return entry.sched_flag;
+	}
+
+	entry.sched_flag = run_schedulability_test(task_vector, sched_mode, resp_time_rd, resp_time_jd, 
+											   req_blocking_rd, job_blocking_jd, resp_time);
+	entry.resp_time = resp_time;
+	entry.resp_time_rd = resp_time_rd;
+	entry.resp_time_jd = resp_time_jd;
+	entry.req_blocking_rd = req_blocking_rd;
+	entry.job_blocking_jd = job_blocking_jd;
+	sched_cache_insert(task_vector, sched_mode, entry);
+	return entry.sched_flag;
+}
+
+/**************** Utility function to check schedulability, iterating the release jitter of split tasks ********************/ 
+static int check_schedulability(std::vector<Task> &task_vector, sched_type sched_mode,
+			 			std::vector<double> &resp_time_rd,
+						std::vector<double> &resp_time_jd,
+						std::vector<std::vector<double>> &req_blocking_rd,
+						std::vector<double> &job_blocking_jd,
+						std::vector<double> &resp_time)
+{
+	std::vector<int> head_index(task_vector.size(), -1);
+	bool jitter_changed = false;
+	int sched_flag;
+
+	// Pair each tail with its head, tails start without jitter
+	for (unsigned int index = 0; index < task_vector.size(); index++)
+	{
+		if (task_vector[index].getSplitPart() != SPLIT_TAIL)
+			continue;
+
+		task_vector[index].setJ(0);
+		for (unsigned int i = 0; i < task_vector.size(); i++)
+		{
+			if (task_vector[i].getSplitPart() == SPLIT_HEAD && task_vector[i].getSplitID() == task_vector[index].getSplitID())
+				head_index[index] = i;
+		}
+		jitter_changed = true;
+	}
+
+	// Fixed point J(tail) = R(head), the response times only grow with the jitter so this terminates
+	do
+	{
+		sched_flag = check_schedulability_cached(task_vector, sched_mode, resp_time_rd, resp_time_jd, 
+												 req_blocking_rd, job_blocking_jd, resp_time);
+		if (sched_flag != 0 || !jitter_changed)
+			return sched_flag;
+
+		jitter_changed = false;
+		for (unsigned int index = 0; index < task_vector.size(); index++)
+		{
+			if (head_index[index] < 0 || resp_time[head_index[index]] == task_vector[index].getJ())
+				continue;
+			task_vector[index].setJ(resp_time[head_index[index]]);
+			jitter_changed = true;
+		}
+	} while (jitter_changed);
+
+	return sched_flag;
+}
+
+/**************** Response Times of a Partition ********************/ 
+int get_partition_response_times(std::vector<Task> &task_vector, sched_type sched_mode, std::vector<double> &resp_time)
+{
+	std::vector<double> resp_time_rd;
+	std::vector<double> resp_time_jd;
+	std::vector<std::vector<double>> req_blocking_rd;
+	std::vector<double> job_blocking_jd;
+
+	return check_schedulability(task_vector, sched_mode, resp_time_rd, resp_time_jd, req_blocking_rd, job_blocking_jd, resp_time);
+}
+
+/**************** The Seeded WFD Partitioning Algorithm ********************/ 
+int worst_fit_decreasing_seeded(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+								std::vector<double> &resp_time_rd,
+								std::vector<double> &resp_time_jd,
+								std::vector<std::vector<double>> &req_blocking_rd,
+								std::vector<double> &job_blocking_jd,
+								std::function<bool(Task const &, Task const &)> priority_ordering)
 {
 	std::vector<Task> wfd_ordered_tasks;
 	std::vector<Task> wfd_mapped_tasks;
-	std::vector<double> core_util(num_cores, 0.0);
-	std::vector<unsigned int> exclusion_list;
+	std::vector<Task> seeded_tasks;
+	CoreUtilHeap core_heap(num_cores, 0);
+	std::vector<double> resp_time;
 	unsigned int chosen_core;
 	int sched_flag;
 
-	// Mark all cores as un-allocated -> setCoreId = num_cores
+	// Tasks already on a core keep their mapping, the others are placed by WFD
 	for (unsigned int index = 0; index < task_vector.size(); index++)
-		task_vector[index].setCoreID(num_cores);
+	{
+		if (task_vector[index].getCoreID() < num_cores)
+		{
+			seeded_tasks.push_back(task_vector[index]);
+			core_heap.addUtil(task_vector[index].getCoreID(), (task_vector[index].getC()+task_vector[index].getTotalGm())/task_vector[index].getT());
+		}
+		else
+		{
+			task_vector[index].setCoreID(num_cores);
+			wfd_ordered_tasks.push_back(task_vector[index]);
+		}
+	}
+	wfd_mapped_tasks = seeded_tasks;
 
-	// Initialize WFD vector
-	wfd_ordered_tasks = task_vector;
+	// Nothing left to place -> just check the seed mapping
+	if (wfd_ordered_tasks.empty())
+	{
+		std::sort(wfd_mapped_tasks.begin(), wfd_mapped_tasks.end(), priority_ordering);
+		sched_flag = check_schedulability(wfd_mapped_tasks, sched_mode, resp_time_rd, 
+										  resp_time_jd, req_blocking_rd, job_blocking_jd, resp_time);
+		task_vector = wfd_mapped_tasks;
+		return sched_flag;
+	}
 
 	// Sort Vector based on Utilization
 	std::sort(wfd_ordered_tasks.begin(), wfd_ordered_tasks.end(), CompareTaskUtilWFD);
@@ -186,14 +310,14 @@ int worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_ty
 	for (unsigned int index = 0; index < wfd_ordered_tasks.size(); index++)
 	{
 		sched_flag = 1;
-		exclusion_list.clear();
+		core_heap.clearExclusions();
 		double task_util = (wfd_ordered_tasks[index].getC()+wfd_ordered_tasks[index].getTotalGm())/wfd_ordered_tasks[index].getT();
 
 		// Try cores until schedulable
 		while (sched_flag != 0)
 		{
 			// Find core with min util
-			chosen_core = find_minutil_core_excluding(core_util, 0, exclusion_list);
+			chosen_core = core_heap.getMinCore();
 
 			// Allocate the task to that core
 			wfd_ordered_tasks[index].setCoreID(chosen_core);
@@ -207,22 +331,27 @@ int worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_ty
 
 			// Check Schedulability
 			sched_flag = check_schedulability(wfd_mapped_tasks, sched_mode, resp_time_rd, 
-										      resp_time_jd, req_blocking_rd, job_blocking_jd);
+										      resp_time_jd, req_blocking_rd, job_blocking_jd, resp_time);
 
 			// If not schedulable declare an unfeasible partition
 			if (sched_flag != 0)
 			{
-				if (exclusion_list.size() == num_cores-1)
+				if (core_heap.getNumExcluded() == num_cores-1)
 				{
+					// Hand back the partial mapping, the tasks not yet placed remain on core num_cores
+					wfd_ordered_tasks[index].setCoreID(num_cores);
+					wfd_ordered_tasks.insert(wfd_ordered_tasks.end(), seeded_tasks.begin(), seeded_tasks.end());
+					std::sort(wfd_ordered_tasks.begin(), wfd_ordered_tasks.end(), priority_ordering);
+					task_vector = wfd_ordered_tasks;
 					return -1;
 				}
 				else
-					exclusion_list.push_back(chosen_core);
+					core_heap.exclude(chosen_core);
 			}
 		}
 
 		// Update the core utilization
-		core_util[chosen_core] = core_util[chosen_core] + task_util;
+		core_heap.addUtil(chosen_core, task_util);
 	}
 
 	// Copy over vector with core mappings 
@@ -230,29 +359,177 @@ int worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_ty
 	return 0;
 }
 
-/**************** The Synchronization-Aware WFD Partitioning Algorithm ********************/ 
-int sync_aware_worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
-						 			std::vector<double> &resp_time_rd,
-									std::vector<double> &resp_time_jd,
-									std::vector<std::vector<double>> &req_blocking_rd,
-									std::vector<double> &job_blocking_jd,
-									std::function<bool(Task const &, Task const &)> priority_ordering)
+/**************** The WFD Partitioning Algorithm ********************/ 
+int worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+						 std::vector<double> &resp_time_rd,
+						 std::vector<double> &resp_time_jd,
+						 std::vector<std::vector<double>> &req_blocking_rd,
+						 std::vector<double> &job_blocking_jd,
+						 std::function<bool(Task const &, Task const &)> priority_ordering)
+{
+	// Mark all cores as un-allocated -> setCoreId = num_cores
+	for (unsigned int index = 0; index < task_vector.size(); index++)
+		task_vector[index].setCoreID(num_cores);
+
+	return worst_fit_decreasing_seeded(task_vector, num_cores, sched_mode, resp_time_rd, resp_time_jd, 
+									   req_blocking_rd, job_blocking_jd, priority_ordering);
+}
+
+/**************** Split a task across two cores (head on one core, tail on another) ********************/ 
+static int split_task_across_cores(std::vector<Task> &task_vector, unsigned int split_index, int num_cores, sched_type sched_mode,
+								   std::vector<double> &resp_time_rd,
+								   std::vector<double> &resp_time_jd,
+								   std::vector<std::vector<double>> &req_blocking_rd,
+								   std::vector<double> &job_blocking_jd,
+								   std::function<bool(Task const &, Task const &)> priority_ordering,
+								   unsigned int split_id)
+{
+	std::vector<Task> mapped_tasks;
+	std::vector<Task> unplaced_tasks;
+	std::vector<Task> trial_tasks;
+	std::vector<double> resp_time;
+	std::vector<unsigned int> core_order;
+	std::vector<double> core_util(num_cores, 0.0);
+	double head_C, low_C, high_C, mid_C;
+
+	// Only the mapped tasks take part in the analysis
+	for (unsigned int index = 0; index < task_vector.size(); index++)
+	{
+		if (index == split_index)
+			continue;
+		if (task_vector[index].getCoreID() < num_cores)
+		{
+			mapped_tasks.push_back(task_vector[index]);
+			core_util[task_vector[index].getCoreID()] += (task_vector[index].getC()+task_vector[index].getTotalGm())/task_vector[index].getT();
+		}
+		else
+			unplaced_tasks.push_back(task_vector[index]);
+	}
+
+	// Try the least loaded cores first (ties -> lowest core id)
+	for (unsigned int core = 0; core < num_cores; core++)
+		core_order.push_back(core);
+	std::stable_sort(core_order.begin(), core_order.end(), [&core_util](unsigned int a, unsigned int b) { return core_util[a] < core_util[b]; });
+
+	for (unsigned int head_core : core_order)
+	{
+		// Bisect the largest head budget this core accepts on its own
+		low_C = 0;
+		high_C = task_vector[split_index].getC();
+		for (unsigned int step = 0; step < SPLIT_SEARCH_STEPS; step++)
+		{
+			mid_C = (low_C + high_C)/2;
+			Task head = task_vector[split_index];
+			head.splitTask(mid_C, split_id);
+			head.setCoreID(head_core);
+
+			trial_tasks = mapped_tasks;
+			trial_tasks.push_back(head);
+			std::sort(trial_tasks.begin(), trial_tasks.end(), priority_ordering);
+			if (check_schedulability(trial_tasks, sched_mode, resp_time_rd, resp_time_jd, 
+									 req_blocking_rd, job_blocking_jd, resp_time) == 0)
+				low_C = mid_C;
+			else
+				high_C = mid_C;
+		}
+		if (low_C <= 0)
+			continue;
+
+		// Place the tail, shrinking the head (and so the tail jitter) if needed
+		for (unsigned int tail_core : core_order)
+		{
+			if (tail_core == head_core)
+				continue;
+
+			for (unsigned int backoff = 0; backoff < SPLIT_BACKOFF_STEPS; backoff++)
+			{
+				head_C = low_C*(SPLIT_BACKOFF_STEPS - backoff)/SPLIT_BACKOFF_STEPS;
+				Task head = task_vector[split_index];
+				Task tail = head.splitTask(head_C, split_id);
+				head.setCoreID(head_core);
+				tail.setCoreID(tail_core);
+
+				trial_tasks = mapped_tasks;
+				trial_tasks.push_back(head);
+				trial_tasks.push_back(tail);
+				std::sort(trial_tasks.begin(), trial_tasks.end(), priority_ordering);
+				if (check_schedulability(trial_tasks, sched_mode, resp_time_rd, resp_time_jd, 
+										 req_blocking_rd, job_blocking_jd, resp_time) == 0)
+				{
+					// Hand back the mapping with the split task, the other unplaced tasks remain on core num_cores
+					trial_tasks.insert(trial_tasks.end(), unplaced_tasks.begin(), unplaced_tasks.end());
+					std::sort(trial_tasks.begin(), trial_tasks.end(), priority_ordering);
+					task_vector = trial_tasks;
+					return 0;
+				}
+			}
+		}
+	}
+	return -1;
+}
+
+/**************** The Semi-Partitioned WFD Partitioning Algorithm ********************/ 
+int semi_partitioned_worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+										  std::vector<double> &resp_time_rd,
+										  std::vector<double> &resp_time_jd,
+										  std::vector<std::vector<double>> &req_blocking_rd,
+										  std::vector<double> &job_blocking_jd,
+										  std::function<bool(Task const &, Task const &)> priority_ordering)
+{
+	unsigned int split_id = 0;
+	int split_index;
+	double max_util, task_util;
+
+	int sched_flag = worst_fit_decreasing(task_vector, num_cores, sched_mode, resp_time_rd, resp_time_jd, 
+										  req_blocking_rd, job_blocking_jd, priority_ordering);
+
+	while (sched_flag != 0)
+	{
+		// WFD failed on the heaviest unplaced task, split it and let WFD place the rest
+		split_index = -1;
+		max_util = 0;
+		for (unsigned int index = 0; index < task_vector.size(); index++)
+		{
+			if (task_vector[index].getCoreID() < num_cores)
+				continue;
+			task_util = (task_vector[index].getC()+task_vector[index].getTotalGm())/task_vector[index].getT();
+			if (split_index < 0 || task_util > max_util)
+			{
+				max_util = task_util;
+				split_index = index;
+			}
+		}
+		if (split_index < 0)
+			return -1;
+
+		split_id++;
+		if (split_task_across_cores(task_vector, split_index, num_cores, sched_mode, resp_time_rd, resp_time_jd,
+									req_blocking_rd, job_blocking_jd, priority_ordering, split_id) != 0)
+			return -1;
+
+		sched_flag = worst_fit_decreasing_seeded(task_vector, num_cores, sched_mode, resp_time_rd, resp_time_jd, 
+												 req_blocking_rd, job_blocking_jd, priority_ordering);
+	}
+	return 0;
+}
+
+/**************** The Synchronization-Aware WFD with a given number of reserved cores ********************/ 
+static int sync_aware_worst_fit_decreasing_reserved(std::vector<Task> &task_vector, int num_cores, int susp_cores, sched_type sched_mode,
+						 							std::vector<double> &resp_time_rd,
+													std::vector<double> &resp_time_jd,
+													std::vector<std::vector<double>> &req_blocking_rd,
+													std::vector<double> &job_blocking_jd,
+													std::function<bool(Task const &, Task const &)> priority_ordering)
 {
 	std::vector<Task> wfd_ordered_tasks;
 	std::vector<Task> wfd_mapped_tasks;
-	std::vector<double> core_util(num_cores, 0.0);
-	std::vector<unsigned int> exclusion_list;
+	std::vector<double> resp_time;
 	unsigned int chosen_core;
 	int sched_flag;
 
-	// CPU Utilization of tasks using the GPU 
-	double cpu_gputil = get_gputasks_cpu_util(task_vector);
-
-	// Taskset Utilization
-	double cpu_util = get_taskset_cpu_util(task_vector);
-
-	// Cores Reserved for Self suspending tasks
-	int susp_cores = ceil(cpu_gputil/cpu_util)*num_cores;
+	// Core selection heaps, the self-suspending tasks only see the reserved cores
+	CoreUtilHeap susp_heap(num_cores, num_cores - susp_cores);
+	CoreUtilHeap core_heap(num_cores, 0);
 
 	// Mark all cores as un-allocated -> setCoreId = num_cores
 	for (unsigned int index = 0; index < task_vector.size(); index++)
@@ -272,14 +549,14 @@ int sync_aware_worst_fit_decreasing(std::vector<Task> &task_vector, int num_core
 			continue;
 
 		sched_flag = 1;
-		exclusion_list.clear();
+		susp_heap.clearExclusions();
 		double task_util = (wfd_ordered_tasks[index].getC()+wfd_ordered_tasks[index].getTotalGm())/wfd_ordered_tasks[index].getT();
 
 		// Try cores until schedulable
 		while (sched_flag != 0)
 		{
 			// Find core with min util
-			chosen_core = find_minutil_core_excluding(core_util, num_cores - susp_cores, exclusion_list);
+			chosen_core = susp_heap.getMinCore();
 
 			// Allocate the task to that core
 			wfd_ordered_tasks[index].setCoreID(chosen_core);
@@ -293,20 +570,21 @@ int sync_aware_worst_fit_decreasing(std::vector<Task> &task_vector, int num_core
 
 			// Check Schedulability
 			sched_flag = check_schedulability(wfd_mapped_tasks, sched_mode, resp_time_rd, 
-										      resp_time_jd, req_blocking_rd, job_blocking_jd);
+										      resp_time_jd, req_blocking_rd, job_blocking_jd, resp_time);
 
 			// If not schedulable declare an unfeasible partition
 			if (sched_flag != 0)
 			{
-				if (exclusion_list.size() == susp_cores)
+				if (susp_heap.getNumExcluded() == susp_cores)
 					return -1;
 				else
-					exclusion_list.push_back(chosen_core);
+					susp_heap.exclude(chosen_core);
 			}
 		}
 
 		// Update the core utilization
-		core_util[chosen_core] = core_util[chosen_core] + task_util;
+		susp_heap.addUtil(chosen_core, task_util);
+		core_heap.addUtil(chosen_core, task_util);
 	}
 
 	// Assign tasks without self suspensions
@@ -317,14 +595,14 @@ int sync_aware_worst_fit_decreasing(std::vector<Task> &task_vector, int num_core
 			continue;
 
 		sched_flag = 1;
-		exclusion_list.clear();
+		core_heap.clearExclusions();
 		double task_util = (wfd_ordered_tasks[index].getC()+wfd_ordered_tasks[index].getTotalGm())/wfd_ordered_tasks[index].getT();
 
 		// Try cores until schedulable
 		while (sched_flag != 0)
 		{
 			// Find core with min util
-			chosen_core = find_minutil_core_excluding(core_util, 0, exclusion_list);
+			chosen_core = core_heap.getMinCore();
 
 			// Allocate the task to that core
 			wfd_ordered_tasks[index].setCoreID(chosen_core);
@@ -338,20 +616,20 @@ int sync_aware_worst_fit_decreasing(std::vector<Task> &task_vector, int num_core
 
 			// Check Schedulability
 			sched_flag = check_schedulability(wfd_mapped_tasks, sched_mode, resp_time_rd, 
-										      resp_time_jd, req_blocking_rd, job_blocking_jd);
+										      resp_time_jd, req_blocking_rd, job_blocking_jd, resp_time);
 
 			// If not schedulable declare an unfeasible partition
 			if (sched_flag != 0)
 			{
-				if (exclusion_list.size() == num_cores)
+				if (core_heap.getNumExcluded() == num_cores)
 					return -1;
 				else
-					exclusion_list.push_back(chosen_core);
+					core_heap.exclude(chosen_core);
 			}
 		}
 
 		// Update the core utilization
-		core_util[chosen_core] = core_util[chosen_core] + task_util;
+		core_heap.addUtil(chosen_core, task_util);
 	}
 
 	// Copy over vector with core mappings 
@@ -360,4 +638,325 @@ int sync_aware_worst_fit_decreasing(std::vector<Task> &task_vector, int num_core
 	return 0;
 }
 
+/**************** The Synchronization-Aware WFD Partitioning Algorithm ********************/ 
+int sync_aware_worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+						 			std::vector<double> &resp_time_rd,
+									std::vector<double> &resp_time_jd,
+									std::vector<std::vector<double>> &req_blocking_rd,
+									std::vector<double> &job_blocking_jd,
+									std::function<bool(Task const &, Task const &)> priority_ordering)
+{
+	std::vector<int> reservations;
+	int min_cores, load_cores;
+
+	// CPU Utilization of tasks using the GPU 
+	double cpu_gputil = get_gputasks_cpu_util(task_vector);
+
+	// Taskset Utilization
+	double cpu_util = get_taskset_cpu_util(task_vector);
+
+	// No self-suspending tasks -> plain WFD over all the cores
+	if (cpu_gputil == 0)
+		return sync_aware_worst_fit_decreasing_reserved(task_vector, num_cores, 0, sched_mode, resp_time_rd, resp_time_jd, 
+														req_blocking_rd, job_blocking_jd, priority_ordering);
+
+	// Cores Reserved for Self suspending tasks -> share of the cores proportional to their CPU load,
+	// but at least enough cores to hold that load
+	min_cores = std::min(num_cores, std::max(1, (int) ceil(cpu_gputil - EPSILON_FLO)));
+	load_cores = std::min(num_cores, std::max(min_cores, (int) ceil(cpu_gputil/cpu_util*num_cores - EPSILON_FLO)));
+
+	// Tune the reservation by trying the sizes closest to the load-based one first (larger ones on ties)
+	reservations.push_back(load_cores);
+	for (int distance = 1; distance < num_cores; distance++)
+	{
+		if (load_cores + distance <= num_cores)
+			reservations.push_back(load_cores + distance);
+		if (load_cores - distance >= min_cores)
+			reservations.push_back(load_cores - distance);
+	}
+
+	for (unsigned int index = 0; index < reservations.size(); index++)
+	{
+		if (sync_aware_worst_fit_decreasing_reserved(task_vector, num_cores, reservations[index], sched_mode, resp_time_rd, resp_time_jd, 
+													 req_blocking_rd, job_blocking_jd, priority_ordering) == 0)
+			return 0;
+	}
+	return -1;
+}
+
+/**************** Cost of a mapping for the local search ********************/ 
+// Every task missing its deadline adds one plus its lateness (R - D) normalized by the deadline
+static double calculate_mapping_cost(const std::vector<Task> &task_vector, const std::vector<double> &resp_time)
+{
+	double cost = 0;
+
+	for (unsigned int index = 0; index < task_vector.size(); index++)
+	{
+		if (resp_time[index] > task_vector[index].getD())
+			cost = cost + 1 + (resp_time[index] - task_vector[index].getD())/task_vector[index].getD();
+	}
+	return cost;
+}
+
+/**************** Propose a slack-guided move or swap for the local search ********************/ 
+static void propose_local_search_move(std::vector<Task> &task_vector, const std::vector<double> &resp_time,
+									  int num_cores, std::mt19937 &rng)
+{
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::vector<double> lateness(task_vector.size(), 0.0);
+	std::vector<double> core_slack(num_cores, 1.0);
+	std::vector<unsigned int> candidates;
+	unsigned int victim, mover, victim_core, target_core;
+	double slack, best_slack;
+
+	// Pick the victim among the tasks with negative slack (D - R), weighted by how late they are
+	for (unsigned int index = 0; index < task_vector.size(); index++)
+	{
+		slack = (task_vector[index].getD() - resp_time[index])/task_vector[index].getD();
+		if (slack < 0)
+			lateness[index] = -slack + EPSILON_FLO;
+		if (slack < core_slack[task_vector[index].getCoreID()])
+			core_slack[task_vector[index].getCoreID()] = slack;
+	}
+	std::discrete_distribution<unsigned int> pick_victim(lateness.begin(), lateness.end());
+	victim = pick_victim(rng);
+	victim_core = task_vector[victim].getCoreID();
+
+	// Either move the victim itself, or relieve it by moving one of its higher-priority interferers
+	mover = victim;
+	if (uniform(rng) < 0.5)
+	{
+		for (unsigned int index = 0; index < victim; index++)
+		{
+			if (task_vector[index].getCoreID() == victim_core)
+				candidates.push_back(index);
+		}
+		if (!candidates.empty())
+			mover = candidates[rng() % candidates.size()];
+	}
+
+	// Target the core with the most slack, occasionally a random one to escape local minima
+	target_core = (victim_core + 1 + rng() % (num_cores - 1)) % num_cores;
+	if (uniform(rng) >= LS_EXPLORE_PROBABILITY)
+	{
+		best_slack = -std::numeric_limits<double>::infinity();
+		for (unsigned int core = 0; core < num_cores; core++)
+		{
+			if (core != victim_core && core_slack[core] > best_slack)
+			{
+				best_slack = core_slack[core];
+				target_core = core;
+			}
+		}
+	}
+
+	// Swap with a lighter task on the target core, or simply move
+	candidates.clear();
+	if (uniform(rng) < LS_SWAP_PROBABILITY)
+	{
+		double mover_util = (task_vector[mover].getC()+task_vector[mover].getTotalGm())/task_vector[mover].getT();
+		for (unsigned int index = 0; index < task_vector.size(); index++)
+		{
+			if (task_vector[index].getCoreID() == target_core && 
+			    (task_vector[index].getC()+task_vector[index].getTotalGm())/task_vector[index].getT() < mover_util)
+				candidates.push_back(index);
+		}
+	}
+	if (!candidates.empty())
+		task_vector[candidates[rng() % candidates.size()]].setCoreID(victim_core);
+	task_vector[mover].setCoreID(target_core);
+}
+
+/**************** Run one simulated-annealing restart of the local search ********************/ 
+static void run_local_search_restart(std::vector<Task> task_vector, int num_cores, sched_type sched_mode,
+									 unsigned int seed, unsigned int restart, int max_iterations,
+									 std::atomic<bool> &found_flag, std::mutex &result_lock,
+									 std::vector<Task> &result, std::vector<unsigned long> &cache_stats)
+{
+	unsigned long cache_hits, cache_misses, cache_evictions;
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::vector<double> resp_time_rd, resp_time_jd, job_blocking_jd;
+	std::vector<std::vector<double>> req_blocking_rd;
+	std::vector<double> resp_time, cand_resp_time;
+	std::vector<Task> candidate;
+	double temperature = LS_INITIAL_TEMPERATURE;
+	double cost, cand_cost;
+	int sched_flag, cand_flag;
+
+	// Diversify all but the first restart by scattering a few tasks randomly
+	if (restart > 0)
+	{
+		for (unsigned int move = 0; move < restart && move < task_vector.size(); move++)
+			task_vector[rng() % task_vector.size()].setCoreID(rng() % num_cores);
+	}
+
+	sched_flag = check_schedulability(task_vector, sched_mode, resp_time_rd, resp_time_jd, 
+									  req_blocking_rd, job_blocking_jd, resp_time);
+	cost = calculate_mapping_cost(task_vector, resp_time);
+
+	for (int iteration = 0; iteration < max_iterations && sched_flag != 0 && !found_flag; iteration++)
+	{
+		candidate = task_vector;
+		propose_local_search_move(candidate, resp_time, num_cores, rng);
+		cand_flag = check_schedulability(candidate, sched_mode, resp_time_rd, resp_time_jd, 
+										 req_blocking_rd, job_blocking_jd, cand_resp_time);
+		cand_cost = calculate_mapping_cost(candidate, cand_resp_time);
+
+		// Metropolis acceptance criterion
+		if (cand_flag == 0 || cand_cost <= cost || uniform(rng) < exp((cost - cand_cost)/temperature))
+		{
+			task_vector.swap(candidate);
+			resp_time.swap(cand_resp_time);
+			cost = cand_cost;
+			sched_flag = cand_flag;
+		}
+		temperature = temperature*LS_COOLING_RATE;
+	}
+
+	// Publish the first feasible mapping found, and the counters of this thread's verdict cache
+	sched_cache_get_stats(cache_hits, cache_misses, cache_evictions);
+	std::lock_guard<std::mutex> guard(result_lock);
+	if (sched_flag == 0 && !found_flag)
+	{
+		result = task_vector;
+		found_flag = true;
+	}
+	cache_stats[0] += cache_hits;
+	cache_stats[1] += cache_misses;
+	cache_stats[2] += cache_evictions;
+}
+
+/**************** The Local-Search Repartitioning Algorithm ********************/ 
+int local_search_partitioning(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+							  std::vector<double> &resp_time_rd,
+							  std::vector<double> &resp_time_jd,
+							  std::vector<std::vector<double>> &req_blocking_rd,
+							  std::vector<double> &job_blocking_jd,
+							  std::function<bool(Task const &, Task const &)> priority_ordering,
+							  int num_restarts, int max_iterations)
+{
+	std::vector<Task> seed_tasks = task_vector;
+	std::vector<double> core_util(num_cores, 0.0);
+	std::vector<unsigned int> unplaced;
+	std::vector<std::thread> workers;
+	std::vector<double> resp_time;
+	std::vector<Task> result;
+	std::vector<unsigned long> cache_stats(3, 0);	// hits, misses and evictions of the restarts
+	std::atomic<bool> found_flag(false);
+	std::mutex result_lock;
+	unsigned int chosen_core;
+	unsigned int base_seed;
+
+	// Nothing to move tasks between
+	if (num_cores < 2 || num_restarts < 1 || task_vector.empty())
+		return -1;
+
+	// Draw the seed from the caller's random stream
+	base_seed = taskset_rand();
+
+	// Sort Tasks according to the priority ordering (moves only change core ids, not priorities)
+	std::sort(seed_tasks.begin(), seed_tasks.end(), priority_ordering);
+
+	// Compute the core utilization of the partial mapping
+	for (unsigned int index = 0; index < seed_tasks.size(); index++)
+	{
+		if (seed_tasks[index].getCoreID() < num_cores)
+			core_util[seed_tasks[index].getCoreID()] += (seed_tasks[index].getC()+seed_tasks[index].getTotalGm())/seed_tasks[index].getT();
+		else
+			unplaced.push_back(index);
+	}
+
+	// Place the remaining tasks worst-fit (decreasing utilization), the search will repair them
+	std::sort(unplaced.begin(), unplaced.end(), [&seed_tasks](unsigned int a, unsigned int b) {
+		return CompareTaskUtilWFD(seed_tasks[a], seed_tasks[b]);
+	});
+	for (unsigned int index = 0; index < unplaced.size(); index++)
+	{
+		Task &task = seed_tasks[unplaced[index]];
+		chosen_core = find_minutil_core(core_util, 0);
+		task.setCoreID(chosen_core);
+		core_util[chosen_core] += (task.getC()+task.getTotalGm())/task.getT();
+	}
+
+	// Run the restarts in parallel -> the verdict is deterministic, only the winning mapping may vary
+	for (int restart = 0; restart < num_restarts; restart++)
+		workers.push_back(std::thread(run_local_search_restart, seed_tasks, num_cores, sched_mode,
+									  base_seed + restart, restart, max_iterations,
+									  std::ref(found_flag), std::ref(result_lock), std::ref(result), std::ref(cache_stats)));
+	for (unsigned int index = 0; index < workers.size(); index++)
+		workers[index].join();
+	sched_cache_add_stats(cache_stats[0], cache_stats[1], cache_stats[2]);
+
+	if (!found_flag)
+		return -1;
+
+	// Re-run the test on the winning mapping to populate the response-time and blocking vectors
+	task_vector = result;
+	return check_schedulability(task_vector, sched_mode, resp_time_rd, resp_time_jd, 
+								req_blocking_rd, job_blocking_jd, resp_time);
+}
 
+/**************** Minimum Core Count Search using WFD ********************/ 
+int find_min_cores_wfd(std::vector<Task> &task_vector, int max_cores, sched_type sched_mode,
+					   std::vector<double> &resp_time_rd,
+					   std::vector<double> &resp_time_jd,
+					   std::vector<std::vector<double>> &req_blocking_rd,
+					   std::vector<double> &job_blocking_jd,
+					   std::function<bool(Task const &, Task const &)> priority_ordering)
+{
+	std::vector<Task> best_mapping = task_vector;
+	std::vector<Task> probe_mapping;
+	int min_cores, max_feasible_cores, probe_cores;
+	int sched_flag;
+
+	// The total utilization gives a lower bound on the number of cores
+	min_cores = (int)ceil(get_taskset_cpu_util(task_vector) - EPSILON_FLO);
+	if (min_cores < 1)
+		min_cores = 1;
+	if (min_cores > max_cores)
+		return -1;
+
+	// Probe the largest platform first, if it is infeasible there is nothing to search
+	sched_flag = worst_fit_decreasing(best_mapping, max_cores, sched_mode, resp_time_rd, resp_time_jd,
+									  req_blocking_rd, job_blocking_jd, priority_ordering);
+	if (sched_flag != 0)
+		return -1;
+	max_feasible_cores = max_cores;
+
+	// Binary search over the number of cores
+	while (min_cores < max_feasible_cores)
+	{
+		probe_cores = (min_cores + max_feasible_cores)/2;
+
+		// Reuse the smallest feasible mapping: only the tasks on the removed cores are re-placed
+		probe_mapping = best_mapping;
+		for (unsigned int index = 0; index < probe_mapping.size(); index++)
+		{
+			if (probe_mapping[index].getCoreID() >= probe_cores)
+				probe_mapping[index].setCoreID(probe_cores);
+		}
+		sched_flag = worst_fit_decreasing_seeded(probe_mapping, probe_cores, sched_mode, resp_time_rd, resp_time_jd,
+												 req_blocking_rd, job_blocking_jd, priority_ordering);
+
+		// Fall back on a fresh WFD partition
+		if (sched_flag != 0)
+		{
+			probe_mapping = task_vector;
+			sched_flag = worst_fit_decreasing(probe_mapping, probe_cores, sched_mode, resp_time_rd, resp_time_jd,
+											  req_blocking_rd, job_blocking_jd, priority_ordering);
+		}
+
+		if (sched_flag == 0)
+		{
+			max_feasible_cores = probe_cores;
+			best_mapping = probe_mapping;
+		}
+		else
+			min_cores = probe_cores + 1;
+	}
+
+	// Copy over vector with core mappings
+	task_vector = best_mapping;
+	return max_feasible_cores;
+}
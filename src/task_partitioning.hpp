@@ -29,6 +29,7 @@
 
 /* Standard Library Imports */
 #include <vector>
+#include <string>
 #include <functional>
 
 /* Internal Headers */
@@ -49,6 +50,18 @@ enum sched_type
 	INVALID 						= 9
 };
 
+/* Names of the schedulability tests, and short keys (CSV columns, kernel names), indexed by sched_type */
+extern const char *sched_type_names[INVALID];
+extern const char *sched_type_keys[INVALID];
+
+/* Width of the test column in the drivers' tables */
+#define SCHED_TYPE_LABEL_WIDTH 22
+
+/**************** Name of a schedulability test, padded for the drivers' tables ********************/ 
+/* Params: test: sched_type below INVALID
+   Returns: the name, padded with blanks to SCHED_TYPE_LABEL_WIDTH */
+std::string get_sched_type_label(int test);
+
 /**************** The WFD Partitioning Algorithm ********************/ 
 /* Params: task_vector       : vector of tasks 
 		   num_cores         : number of cores
@@ -58,7 +71,7 @@ enum sched_type
 		   req_blocking: direct blocking faced by individual requests (using the request-driven approach)
 		   job_blocking: direct blocking faced by individual requests (using the job-driven approach)
 		   priority_ordering : std::sort operator specifying priority ordering of tasks
-   Returns: 0 if a feasible partition exists */
+   Returns: 0 if a feasible partition exists, otherwise task_vector holds the partial mapping (unplaced tasks on core num_cores) */
 int worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
 						 std::vector<double> &resp_time_rd,
 						 std::vector<double> &resp_time_jd,
@@ -66,8 +79,34 @@ int worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_ty
 						 std::vector<double> &job_blocking_jd,
 						 std::function<bool(Task const &, Task const &)> priority_ordering);
 
+/**************** The Seeded WFD Partitioning Algorithm ********************/ 
+/* Same as worst_fit_decreasing, but the tasks already mapped to a core (core id < num_cores) keep their mapping
+   Params: see worst_fit_decreasing
+   Returns: 0 if a feasible partition exists, otherwise task_vector holds the partial mapping (unplaced tasks on core num_cores) */
+int worst_fit_decreasing_seeded(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+								std::vector<double> &resp_time_rd,
+								std::vector<double> &resp_time_jd,
+								std::vector<std::vector<double>> &req_blocking_rd,
+								std::vector<double> &job_blocking_jd,
+								std::function<bool(Task const &, Task const &)> priority_ordering);
+
+/**************** The Semi-Partitioned WFD Partitioning Algorithm ********************/ 
+/* WFD, but a task that fits on no single core has its CPU budget split into a head (with the GPU segments)
+   and a tail released when the head completes, each on its own core; the tail is analysed with the head's
+   response time as release jitter
+   Params: see worst_fit_decreasing
+   Returns: 0 if a feasible partition exists, task_vector then holds the split tasks as two parts */
+int semi_partitioned_worst_fit_decreasing(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+										  std::vector<double> &resp_time_rd,
+										  std::vector<double> &resp_time_jd,
+										  std::vector<std::vector<double>> &req_blocking_rd,
+										  std::vector<double> &job_blocking_jd,
+										  std::function<bool(Task const &, Task const &)> priority_ordering);
+
 /**************** The Synchronization-Aware WFD Partitioning Algorithm ********************/ 
-/* Params: task_vector       : vector of tasks 
+/* The GPU-using tasks are placed first on a reserved subset of the cores, sized from their share of the CPU load;
+   if that fails, the other reservation sizes are tried, closest first
+   Params: task_vector       : vector of tasks 
 		   num_cores         : number of cores
 		   sched_mode        : which schedulability test to use
 		   resp_time_rd: vector of response times of each task (using the request-driven approach)
@@ -82,6 +121,49 @@ int sync_aware_worst_fit_decreasing(std::vector<Task> &task_vector, int num_core
 									std::vector<std::vector<double>> &req_blocking_rd,
 									std::vector<double> &job_blocking_jd,
 									std::function<bool(Task const &, Task const &)> priority_ordering);
+
+/**************** The Local-Search Repartitioning Algorithm ********************/ 
+/* Simulated annealing over moves and swaps between cores, seeded from a (partial) mapping such as
+   the one left by a failed WFD, with moves guided by the per-task slack (D - R)
+   Params: task_vector       : vector of tasks with the seed mapping (core num_cores = unplaced)
+		   num_cores         : number of cores
+		   sched_mode        : which schedulability test to use
+		   resp_time_rd: vector of response times of each task (using the request-driven approach)
+		   resp_time_jd: vector of response times of each task (using the job-driven approach)
+		   req_blocking: direct blocking faced by individual requests (using the request-driven approach)
+		   job_blocking: direct blocking faced by individual requests (using the job-driven approach)
+		   priority_ordering : std::sort operator specifying priority ordering of tasks
+		   num_restarts      : number of restarts, each run in its own thread
+		   max_iterations    : number of moves tried per restart
+   Returns: 0 if a feasible partition is found */
+int local_search_partitioning(std::vector<Task> &task_vector, int num_cores, sched_type sched_mode,
+							  std::vector<double> &resp_time_rd,
+							  std::vector<double> &resp_time_jd,
+							  std::vector<std::vector<double>> &req_blocking_rd,
+							  std::vector<double> &job_blocking_jd,
+							  std::function<bool(Task const &, Task const &)> priority_ordering,
+							  int num_restarts, int max_iterations);
+
+/**************** Response Times of a Partition ********************/ 
+/* Params: task_vector       : vector of tasks with the mapping (e.g. a feasible partition returned above)
+		   sched_mode        : which schedulability test to use
+		   resp_time         : response time of each task, in the order of task_vector (populated by this function)
+   Returns: 0 if the mapping is schedulable */
+int get_partition_response_times(std::vector<Task> &task_vector, sched_type sched_mode, std::vector<double> &resp_time);
+
+/**************** Minimum Core Count Search using WFD ********************/ 
+/* Binary search over the number of cores, each probe reuses the mapping of the smallest feasible probe so far
+   Params: task_vector       : vector of tasks (holds the mapping on the smallest feasible platform on return)
+		   max_cores         : largest number of cores considered
+		   sched_mode        : which schedulability test to use
+		   resp_time_rd, resp_time_jd, req_blocking_rd, job_blocking_jd, priority_ordering: see worst_fit_decreasing
+   Returns: smallest number of cores with a feasible WFD partition, -1 if infeasible on max_cores */
+int find_min_cores_wfd(std::vector<Task> &task_vector, int max_cores, sched_type sched_mode,
+					   std::vector<double> &resp_time_rd,
+					   std::vector<double> &resp_time_jd,
+					   std::vector<std::vector<double>> &req_blocking_rd,
+					   std::vector<double> &job_blocking_jd,
+					   std::function<bool(Task const &, Task const &)> priority_ordering);
 #endif
 
 
@@ -0,0 +1,326 @@
+/*
+ * @file taskset-corpus.cpp
+ * @brief Binary taskset corpus writer and memory-mapped reader implementation
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+
+// Memory mapping
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Include Internal Headers
+#include "taskset-corpus.hpp"
+
+/**************** Corpus Writer ********************/ 
+CorpusWriter::CorpusWriter()
+{
+	opened = false;
+}
+
+CorpusWriter::~CorpusWriter()
+{
+	close();
+}
+
+int CorpusWriter::open(const std::string &filename)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	if (opened)
+		return -1;
+
+	path = filename;
+	tasksets.clear();
+	tasks.clear();
+	segments.clear();
+	opened = true;
+	return 0;
+}
+
+int CorpusWriter::addTaskset(const std::vector<Task> &task_vector)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return recordTaskset(tasksets.size(), task_vector);
+}
+
+int CorpusWriter::addTaskset(unsigned long index, const std::vector<Task> &task_vector)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return recordTaskset(index, task_vector);
+}
+
+int CorpusWriter::recordTaskset(unsigned long index, const std::vector<Task> &task_vector)
+{
+	corpus_taskset_t taskset_entry;
+	corpus_task_t task_entry;
+	corpus_segment_t segment_entry;
+
+	if (!opened || task_vector.empty())
+		return -1;
+
+	// Entries not yet recorded have no tasks, the task and segment tables stay in arrival order
+	if (index >= tasksets.size())
+	{
+		taskset_entry.first_task = 0;
+		taskset_entry.num_tasks = 0;
+		taskset_entry.reserved = 0;
+		tasksets.resize(index + 1, taskset_entry);
+	}
+	else if (tasksets[index].num_tasks != 0)
+		return -1;
+
+	taskset_entry.first_task = tasks.size();
+	taskset_entry.num_tasks = task_vector.size();
+	taskset_entry.reserved = 0;
+	tasksets[index] = taskset_entry;
+
+	for (unsigned int index = 0; index < task_vector.size(); index++)
+	{
+		task_entry.C = task_vector[index].getC();
+		task_entry.D = task_vector[index].getD();
+		task_entry.T = task_vector[index].getT();
+		task_entry.first_segment = segments.size();
+		task_entry.num_segments = task_vector[index].getNumGPUSegments();
+		task_entry.reserved = 0;
+		tasks.push_back(task_entry);
+
+		for (unsigned int j = 0; j < task_entry.num_segments; j++)
+		{
+			segment_entry.Gm = task_vector[index].getGm(j);
+			segment_entry.Ge = task_vector[index].getGe(j);
+			segment_entry.F = task_vector[index].getF(j);
+			segments.push_back(segment_entry);
+		}
+	}
+	return 0;
+}
+
+int CorpusWriter::close()
+{
+	corpus_header_t header;
+
+	std::lock_guard<std::mutex> guard(lock);
+	if (!opened)
+		return -1;
+	opened = false;
+
+	for (unsigned long index = 0; index < tasksets.size(); index++)
+	{
+		if (tasksets[index].num_tasks == 0)
+		{
+			std::cerr << "Corpus: taskset " << index << " was never recorded, " << path << " not written\n";
+			return -1;
+		}
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CORPUS_MAGIC, sizeof(header.magic));
+	header.version = CORPUS_VERSION;
+	header.header_size = sizeof(corpus_header_t);
+	header.num_tasksets = tasksets.size();
+	header.num_tasks = tasks.size();
+	header.num_segments = segments.size();
+	header.taskset_offset = sizeof(corpus_header_t);
+	header.task_offset = header.taskset_offset + tasksets.size()*sizeof(corpus_taskset_t);
+	header.segment_offset = header.task_offset + tasks.size()*sizeof(corpus_task_t);
+
+	std::ofstream outfile(path, std::ios_base::binary | std::ios_base::trunc);
+	if (!outfile)
+	{
+		std::cerr << "Corpus: cannot write " << path << "\n";
+		return -1;
+	}
+	outfile.write((const char *) &header, sizeof(header));
+	outfile.write((const char *) tasksets.data(), tasksets.size()*sizeof(corpus_taskset_t));
+	outfile.write((const char *) tasks.data(), tasks.size()*sizeof(corpus_task_t));
+	outfile.write((const char *) segments.data(), segments.size()*sizeof(corpus_segment_t));
+	outfile.close();
+	if (!outfile)
+		return -1;
+	return 0;
+}
+
+unsigned long CorpusWriter::getNumTasksets() const
+{
+	return tasksets.size();
+}
+
+/**************** Corpus Reader ********************/ 
+CorpusReader::CorpusReader()
+{
+	fd = -1;
+	base = NULL;
+	length = 0;
+	header = NULL;
+	tasksets = NULL;
+	tasks = NULL;
+	segments = NULL;
+}
+
+CorpusReader::~CorpusReader()
+{
+	close();
+}
+
+/**************** Check that a table lies within the file, in a form that cannot overflow ********************/ 
+static bool table_fits(uint64_t offset, uint64_t count, size_t entry_size, size_t alignment, size_t length)
+{
+	return offset <= length && offset % alignment == 0 && count <= (length - offset)/entry_size;
+}
+
+/**************** Check that entries [first, first + count) lie within a table of size entries ********************/ 
+static bool range_fits(uint64_t first, uint64_t count, uint64_t size)
+{
+	return first <= size && count <= size - first;
+}
+
+int CorpusReader::open(const std::string &filename)
+{
+	struct stat file_stat;
+	const char *bytes;
+
+	close();
+	fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0 || fstat(fd, &file_stat) != 0 || (size_t) file_stat.st_size < sizeof(corpus_header_t))
+	{
+		std::cerr << "Corpus: cannot read " << filename << "\n";
+		close();
+		return -1;
+	}
+
+	length = file_stat.st_size;
+	base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (base == MAP_FAILED)
+	{
+		base = NULL;
+		close();
+		return -1;
+	}
+	bytes = (const char *) base;
+	header = (const corpus_header_t *) bytes;
+
+	// The tables must lie within the file, aligned for their entries
+	if (memcmp(header->magic, CORPUS_MAGIC, sizeof(header->magic)) != 0 || header->version != CORPUS_VERSION ||
+		header->header_size != sizeof(corpus_header_t) ||
+		!table_fits(header->taskset_offset, header->num_tasksets, sizeof(corpus_taskset_t), alignof(corpus_taskset_t), length) ||
+		!table_fits(header->task_offset, header->num_tasks, sizeof(corpus_task_t), alignof(corpus_task_t), length) ||
+		!table_fits(header->segment_offset, header->num_segments, sizeof(corpus_segment_t), alignof(corpus_segment_t), length))
+	{
+		std::cerr << "Corpus: " << filename << " is not a valid corpus\n";
+		close();
+		return -1;
+	}
+
+	tasksets = (const corpus_taskset_t *) (bytes + header->taskset_offset);
+	tasks = (const corpus_task_t *) (bytes + header->task_offset);
+	segments = (const corpus_segment_t *) (bytes + header->segment_offset);
+	return 0;
+}
+
+void CorpusReader::close()
+{
+	if (base != NULL)
+		munmap(base, length);
+	if (fd >= 0)
+		::close(fd);
+	fd = -1;
+	base = NULL;
+	length = 0;
+	header = NULL;
+	tasksets = NULL;
+	tasks = NULL;
+	segments = NULL;
+}
+
+unsigned long CorpusReader::getNumTasksets() const
+{
+	if (header == NULL)
+		return 0;
+	return header->num_tasksets;
+}
+
+int CorpusReader::getTaskset(unsigned long index, taskset_view_t &view) const
+{
+	const corpus_taskset_t *entry;
+	const corpus_task_t *last_task;
+
+	if (header == NULL || index >= header->num_tasksets)
+		return -1;
+
+	// Check the taskset against the tables, the corpus may be corrupt
+	entry = &tasksets[index];
+	if (entry->num_tasks == 0 || !range_fits(entry->first_task, entry->num_tasks, header->num_tasks))
+		return -1;
+	last_task = &tasks[entry->first_task + entry->num_tasks - 1];
+	if (!range_fits(last_task->first_segment, last_task->num_segments, header->num_segments))
+		return -1;
+
+	view.tasks = &tasks[entry->first_task];
+	view.num_tasks = entry->num_tasks;
+	view.segments = segments;
+	return 0;
+}
+
+int CorpusReader::materialize(unsigned long index, std::vector<Task> &task_vector) const
+{
+	taskset_view_t view;
+	task_t task_params;
+	gpu_params_t G;
+
+	task_vector.clear();
+	if (getTaskset(index, view) != 0)
+		return -1;
+
+	for (unsigned int i = 0; i < view.num_tasks; i++)
+	{
+		if (!range_fits(view.tasks[i].first_segment, view.tasks[i].num_segments, header->num_segments))
+		{
+			task_vector.clear();
+			return -1;
+		}
+
+		task_params.C = view.tasks[i].C;
+		task_params.D = view.tasks[i].D;
+		task_params.T = view.tasks[i].T;
+		task_params.G.clear();
+		for (unsigned int j = 0; j < view.tasks[i].num_segments; j++)
+		{
+			G.Gm = view.segments[view.tasks[i].first_segment + j].Gm;
+			G.Ge = view.segments[view.tasks[i].first_segment + j].Ge;
+			G.F = view.segments[view.tasks[i].first_segment + j].F;
+			task_params.G.push_back(G);
+		}
+		task_vector.push_back(Task(task_params));
+	}
+	return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * @file taskset-corpus.hpp
+ * @brief Binary taskset corpus writer and memory-mapped reader header
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TASKSET_CORPUS_HPP
+#define TASKSET_CORPUS_HPP
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <cstdint>
+
+#include "task.hpp"
+
+/* Corpus file layout (native byte order, doubles stored bit for bit):
+   header | taskset table | task table | segment table
+   -> the tasks of a taskset are contiguous and in the priority order they were written in,
+      the segments of a task are contiguous as well */
+#define CORPUS_MAGIC "GPUTSC01"
+#define CORPUS_VERSION 1
+
+/* Corpus modes of the drivers */
+#define CORPUS_NONE 0
+#define CORPUS_WRITE 1		// write the generated tasksets to the corpus
+#define CORPUS_READ 2		// analyse the tasksets of the corpus instead of generating
+
+typedef struct corpus_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t header_size;
+	uint64_t num_tasksets;
+	uint64_t num_tasks;
+	uint64_t num_segments;
+	uint64_t taskset_offset;		// byte offsets of the tables from the start of the file
+	uint64_t task_offset;
+	uint64_t segment_offset;
+} corpus_header_t;
+
+typedef struct corpus_taskset {
+	uint64_t first_task;
+	uint32_t num_tasks;
+	uint32_t reserved;
+} corpus_taskset_t;
+
+typedef struct corpus_task {
+	double C;
+	double D;
+	double T;
+	uint64_t first_segment;
+	uint32_t num_segments;
+	uint32_t reserved;
+} corpus_task_t;
+
+typedef struct corpus_segment {
+	double Gm;
+	double Ge;
+	double F;
+} corpus_segment_t;
+
+/* Zero-copy view of one taskset of a mapped corpus, valid while the reader is open */
+typedef struct taskset_view {
+	const corpus_task_t *tasks;
+	unsigned int num_tasks;
+	const corpus_segment_t *segments;	// segment table, index it with tasks[i].first_segment
+} taskset_view_t;
+
+class CorpusWriter
+{
+	// Constructor and destructor (the destructor closes the corpus)
+	public: CorpusWriter();
+	public: ~CorpusWriter();
+
+	// Start a corpus, the file is written on close
+	public: int open(const std::string &filename);
+
+	// Append a taskset (thread-safe), empty tasksets are rejected
+	public: int addTaskset(const std::vector<Task> &task_vector);
+
+	// Record a taskset as entry index (thread-safe), for writers finishing out of order;
+	// every entry below the largest index has to be recorded before close
+	public: int addTaskset(unsigned long index, const std::vector<Task> &task_vector);
+
+	// Write the corpus file, 0 on success
+	public: int close();
+
+	public: unsigned long getNumTasksets() const;
+
+	// Record a taskset (the lock is held by the caller)
+	private: int recordTaskset(unsigned long index, const std::vector<Task> &task_vector);
+
+	// Private Variables
+	private: std::string path;
+	private: bool opened;
+	private: std::vector<corpus_taskset_t> tasksets;
+	private: std::vector<corpus_task_t> tasks;
+	private: std::vector<corpus_segment_t> segments;
+	private: std::mutex lock;
+};
+
+class CorpusReader
+{
+	// Constructor and destructor (the destructor unmaps the corpus)
+	public: CorpusReader();
+	public: ~CorpusReader();
+
+	// Map a corpus and validate its header and tables, 0 on success
+	public: int open(const std::string &filename);
+	public: void close();
+
+	public: unsigned long getNumTasksets() const;
+
+	// Get a zero-copy view of a taskset, 0 on success
+	public: int getTaskset(unsigned long index, taskset_view_t &view) const;
+
+	// Materialize a taskset into the analysis container, 0 on success
+	public: int materialize(unsigned long index, std::vector<Task> &task_vector) const;
+
+	// Private Variables
+	private: int fd;
+	private: void *base;
+	private: size_t length;
+	private: const corpus_header_t *header;
+	private: const corpus_taskset_t *tasksets;
+	private: const corpus_task_t *tasks;
+	private: const corpus_segment_t *segments;
+};
+
+#endif
@@ -30,16 +30,194 @@
 #include <vector>
 #include <cstdlib>
 #include <cmath>
+#include <cfloat>
+#include <limits>
+#include <algorithm>
+#include <random>
+#include <atomic>
+#include <string>
+#include <sstream>
+#include <cstdint>
+#include <mutex>
 
 // Include internal headers
 #include "taskset-gen.hpp"
+#include "sched-config.hpp"
+
+// Utilization sampler statistics (the pipeline generates from several threads)
+static std::atomic<long> sampler_draws(0);
+static std::atomic<long> sampler_discards(0);
+static std::atomic<long> sampler_failures(0);
+
+// Per-thread engine of the pipeline generator threads, the other threads keep using rand()
+static thread_local std::mt19937 thread_engine;
+static thread_local bool thread_engine_seeded = false;
+
+// Engine of the utilization shapes, only seeded for common random numbers
+static thread_local std::mt19937 shape_engine;
+static thread_local bool shape_engine_seeded = false;
+
+/**************** Seed the calling thread's taskset generator ********************/ 
+void seed_taskset_generator(unsigned int seed)
+{
+	thread_engine.seed(seed);
+	thread_engine_seeded = true;
+	shape_engine_seeded = false;
+}
+
+/**************** Seed the calling thread's taskset generator for one taskset of a sweep ********************/ 
+void seed_taskset_stream(unsigned int base_seed, unsigned int index)
+{
+	std::seed_seq structure_seed = {base_seed, index, 0u};
+	std::seed_seq shape_seed = {base_seed, index, 1u};
+
+	thread_engine.seed(structure_seed);
+	shape_engine.seed(shape_seed);
+	thread_engine_seeded = true;
+	shape_engine_seeded = true;
+}
+
+/**************** Build the divisor-rich period set ********************/ 
+/* Params: min_period, max_period: range of the periods
+		   cap: upper bound on the hyperperiod
+   Returns: the divisors in [min_period, max_period] of the best 2^a 3^b 5^c 7^d <= cap, ascending */
+static std::vector<int> build_divisor_periods(uint64_t min_period, uint64_t max_period, uint64_t cap)
+{
+	const uint64_t primes[] = {2, 3, 5, 7};
+	std::vector<uint64_t> smooth(1, 1);
+	uint64_t best = 0;
+	int best_count = 0;
+
+	// All the 7-smooth numbers up to the cap
+	for (uint64_t prime : primes)
+	{
+		unsigned int count = smooth.size();
+		for (unsigned int i = 0; i < count; i++)
+		{
+			for (uint64_t value = smooth[i]*prime; value <= cap; value = value*prime)
+				smooth.push_back(value);
+		}
+	}
+
+	// The one with the most divisors in the period range, the smallest on ties
+	std::sort(smooth.begin(), smooth.end());
+	for (uint64_t value : smooth)
+	{
+		int count = 0;
+		for (uint64_t period = min_period; period <= max_period && period <= value; period++)
+			count += (value % period == 0);
+		if (count > best_count)
+		{
+			best = value;
+			best_count = count;
+		}
+	}
+
+	std::vector<int> periods;
+	for (uint64_t period = min_period; best_count > 0 && period <= max_period && period <= best; period++)
+	{
+		if (best % period == 0)
+			periods.push_back(period);
+	}
+	return periods;
+}
+
+/* Period set of the current configuration, rebuilt when its period range or hyperperiod cap changes */
+static const std::vector<int> &divisor_periods()
+{
+	static std::mutex lock;
+	static std::vector<int> periods;
+	static int built_min_period = 0, built_max_period = 0;
+	static uint64_t built_cap = 0;
+	const sched_config_t &config = get_sched_config();
+
+	std::lock_guard<std::mutex> guard(lock);
+	if (built_cap != config.hyperperiod_cap || built_min_period != config.min_period || built_max_period != config.max_period)
+	{
+		periods = build_divisor_periods(config.min_period, config.max_period, config.hyperperiod_cap);
+		built_min_period = config.min_period;
+		built_max_period = config.max_period;
+		built_cap = config.hyperperiod_cap;
+	}
+	return periods;
+}
+
+/**************** Set the hyperperiod cap of divisor-rich periods ********************/ 
+int set_hyperperiod_cap(uint64_t cap)
+{
+	sched_config_t config = get_sched_config();
+	config.hyperperiod_cap = cap;
+	if (set_sched_config(config) != 0)
+		return 0;
+	return divisor_periods().size();
+}
+
+/**************** Draw a divisor-rich period ********************/ 
+/* Log-uniform in the period range, rounded to the nearest period of the set (in log scale)
+   Params: random: a draw of taskset_rand() */
+static int draw_divisor_period(int random)
+{
+	const std::vector<int> &periods = divisor_periods();
+	const sched_config_t &config = get_sched_config();
+	double target = exp(log((double) config.min_period) + (log((double) config.max_period) - log((double) config.min_period))*
+						((double) random/((double) RAND_MAX + 1)));
+	std::vector<int>::const_iterator upper = std::lower_bound(periods.begin(), periods.end(), target);
+
+	if (upper == periods.begin())
+		return *upper;
+	if (upper == periods.end() || log(target) - log((double) *(upper - 1)) < log((double) *upper) - log(target))
+		return *(upper - 1);
+	return *upper;
+}
+
+/**************** Save and restore the calling thread's taskset generator ********************/ 
+int get_taskset_generator_state(std::string &state)
+{
+	std::ostringstream stream;
+
+	if (!thread_engine_seeded)
+		return -1;
+	stream << thread_engine;
+	state = stream.str();
+	return 0;
+}
+
+int set_taskset_generator_state(const std::string &state)
+{
+	std::istringstream stream(state);
+	std::mt19937 engine;
+
+	stream >> engine;
+	if (stream.fail())
+		return -1;
+	thread_engine = engine;
+	thread_engine_seeded = true;
+	return 0;
+}
+
+/**************** Draw a random number for taskset generation ********************/ 
+int taskset_rand()
+{
+	if (!thread_engine_seeded)
+		return rand();
+	return (int) (thread_engine() % ((unsigned int) RAND_MAX + 1));
+}
+
+/**************** Get the utilization sampler statistics ********************/ 
+void get_util_sampler_stats(long &draws, long &discards, long &failures)
+{
+	draws = sampler_draws;
+	discards = sampler_discards;
+	failures = sampler_failures;
+}
 
 /**************** The UUniFast-Discard Algorithm to generate taskset utilization numbers ********************/ 
-/* Params: number_tasks: number of tasks
+/* Each draw scales the sum left by the previous ones and a draw over the bound ends the attempt, so the loop stays sequential
+   Params: number_tasks: number of tasks
            utilization bound: taskset utilization desired
            task_upper_bound: the upper bound on a single task's utilization
-           utilization_array: vector of generated utilization values */
-int UUniFast(int number_tasks, double utilization_bound, double task_upper_bound, std::vector<double> &utilization_array)
+           utilization_array: generated utilization values (number_tasks of them) */
+int UUniFast(int number_tasks, double utilization_bound, double task_upper_bound, double *utilization_array)
 {
 	double sum;
 	double next_sum;
@@ -51,16 +229,20 @@ int UUniFast(int number_tasks, double utilization_bound, double task_upper_bound
 
 	// Return -1 if the number of tasks are too less
 	if (utilization_bound/number_tasks > task_upper_bound)
+	{
+		sampler_failures++;
 		return -1;
+	}
 
 	for(unifast_iterations = 0; unifast_iterations< terminate_iterations; unifast_iterations++)
 	{ 
+		sampler_draws++;
 		sum = utilization_bound;
 		found_flag = 1;
 		// Generate task utilization values
 		for(i=1; i<number_tasks; i++)
 		{
-			random = (double)(rand() % 10000000)/(double)10000000;
+			random = (double)(taskset_rand() % 10000000)/(double)10000000;
 			next_sum = sum*((double)pow(random, ((double)1/((double)(number_tasks - i)))));
 			utilization_array[i-1] = sum - next_sum;
 			if(utilization_array[i-1] > task_upper_bound)
@@ -83,21 +265,179 @@ int UUniFast(int number_tasks, double utilization_bound, double task_upper_bound
 				found_flag = 0;
 			}
 		}
+		sampler_discards++;
 	}
+	if (found_flag == 0)
+		sampler_failures++;
 	return -(1-found_flag);		// Returns 0 if found, -1 if not
 }
 
+/**************** The RandFixedSum Algorithm to generate taskset utilization numbers ********************/ 
+/* Draws uniformly from the utilization vectors summing to the bound with every task within [0, task_upper_bound],
+   the distribution UUniFast-Discard converges to, without rejections (Stafford's algorithm, as used by Emberson et al.)
+   Params: number_tasks: number of tasks
+           utilization bound: taskset utilization desired
+           task_upper_bound: the upper bound on a single task's utilization
+           utilization_array: generated utilization values (number_tasks of them)
+           arena: holds the simplex tables, as flat rows */
+int RandFixedSum(int number_tasks, double utilization_bound, double task_upper_bound, double *utilization_array, 
+				 taskset_arena_t &arena)
+{
+	int n = number_tasks;
+	int k, column, transition, swap_index;
+	double s, random, sx, sum, product;
+
+	// Return -1 if the number of tasks are too less
+	if (n <= 0 || utilization_bound/n > task_upper_bound)
+	{
+		sampler_failures++;
+		return -1;
+	}
+	sampler_draws++;
+
+	// Rescale to the unit cube, the sum s lies in the slab [k, k+1]
+	s = utilization_bound/task_upper_bound;
+	k = std::max(std::min((int) floor(s), n - 1), 0);
+	s = std::max(std::min(s, (double) k + 1), (double) k);
+
+	arena.s1.resize(n);
+	arena.s2.resize(n);
+	double *s1 = arena.s1.data();
+	double *s2 = arena.s2.data();
+	for (int j = 0; j < n; j++)
+	{
+		s1[j] = s - (k - j);
+		s2[j] = (k + n - j) - s;
+	}
+
+	// Volumes of the simplices (w, rows of n + 1) and the transition probabilities between them (t, rows of n)
+	arena.w.assign(n*(n + 1), 0.0);
+	arena.t.assign(std::max(n - 1, 1)*n, 0.0);
+	double *w = arena.w.data();
+	double *t = arena.t.data();
+	w[1] = DBL_MAX;
+	for (int i = 2; i <= n; i++)
+	{
+		const double *w_prev = &w[(i-2)*(n + 1)];
+		double *w_row = &w[(i-1)*(n + 1)];
+		double *t_row = &t[(i-2)*n];
+
+		// The entries of a row only depend on the previous row
+		for (int q = 0; q < i; q++)
+		{
+			double tmp1 = w_prev[q+1]*s1[q]/i;
+			double tmp2 = w_prev[q]*s2[n-i+q]/i;
+			double tmp3 = tmp1 + tmp2 + std::numeric_limits<double>::denorm_min();
+			w_row[q+1] = tmp1 + tmp2;
+			t_row[q] = (s2[n-i+q] > s1[q]) ? tmp2/tmp3 : 1 - tmp1/tmp3;
+		}
+	}
+
+	// Walk back through the table, choosing a simplex and a point within it
+	column = k;
+	sum = 0;
+	product = 1;
+	for (int i = n - 1; i >= 1; i--)
+	{
+		random = (double)(taskset_rand() % 10000000)/(double)10000000;
+		transition = (random <= t[(i-1)*n + column]) ? 1 : 0;
+		random = (double)(taskset_rand() % 10000000)/(double)10000000;
+		sx = pow(random, (double)1/(double)i);
+		sum = sum + (1 - sx)*product*s/(i + 1);
+		product = sx*product;
+		utilization_array[n-i-1] = sum + product*transition;
+		s = s - transition;
+		column = column - transition;
+	}
+	utilization_array[n-1] = sum + product*s;
+
+	// Randomly permute the tasks and scale back
+	for (int i = n - 1; i > 0; i--)
+	{
+		swap_index = taskset_rand() % (i + 1);
+		std::swap(utilization_array[i], utilization_array[swap_index]);
+	}
+	for (int i = 0; i < n; i++)
+		utilization_array[i] = utilization_array[i]*task_upper_bound;
+
+	return 0;
+}
+
+/**************** Rescale a common utilization shape to the bound ********************/ 
+/* A uniform point of the unit simplex (UUniFast with a bound of 1) scaled by the bound is uniform on the simplex of the bound,
+   so discarding the vectors over task_upper_bound gives the UUniFast-Discard (and RandFixedSum) distribution at every bound;
+   a whole shape is drawn before it is checked, the draws and the powers of an attempt are independent loops
+   Params: see UUniFast, the shape is drawn from the shape engine
+           arena: holds the draws of an attempt */
+int ScaledShape(int number_tasks, double utilization_bound, double task_upper_bound, double *utilization_array, 
+				taskset_arena_t &arena)
+{
+	double sum, next_sum;
+	int found_flag = 0;
+	int terminate_iterations = 1000;	// Iterations to terminate if any task has util > task_upper_bound
+
+	// Return -1 if the number of tasks are too less
+	if (number_tasks <= 0 || utilization_bound/number_tasks > task_upper_bound)
+	{
+		sampler_failures++;
+		return -1;
+	}
+
+	arena.random.resize(number_tasks);
+	double *random = arena.random.data();
+	for (int iterations = 0; iterations < terminate_iterations && !found_flag; iterations++)
+	{
+		sampler_draws++;
+
+		// Draw the whole shape even once it is discarded, the k-th shape is then the same at every bound
+		for (int i = 1; i < number_tasks; i++)
+			random[i-1] = (double)(shape_engine() % 10000000)/(double)10000000;
+		for (int i = 1; i < number_tasks; i++)
+			random[i-1] = pow(random[i-1], (double)1/(double)(number_tasks - i));
+		random[number_tasks-1] = 0;
+
+		// Partial sums of the shape, then the utilizations as their differences
+		sum = 1;
+		found_flag = 1;
+		for (int i = 0; i < number_tasks; i++)
+		{
+			next_sum = sum*random[i];
+			utilization_array[i] = (sum - next_sum)*utilization_bound;
+			sum = next_sum;
+		}
+		for (int i = 0; i < number_tasks; i++)
+			found_flag = found_flag & (utilization_array[i] <= task_upper_bound);
+
+		if (!found_flag)
+			sampler_discards++;
+	}
+	if (!found_flag)
+		sampler_failures++;
+	return -(1-found_flag);
+}
+
+/**************** Draw taskset utilization numbers with the configured sampler ********************/ 
+int draw_utilizations(int number_tasks, double utilization_bound, double task_upper_bound, double *utilization_array,
+					  taskset_arena_t &arena)
+{
+	if (shape_engine_seeded)
+		return ScaledShape(number_tasks, utilization_bound, task_upper_bound, utilization_array, arena);
+	if (get_sched_config().util_sampler == UTIL_SAMPLER_RANDFIXEDSUM)
+		return RandFixedSum(number_tasks, utilization_bound, task_upper_bound, utilization_array, arena);
+	return UUniFast(number_tasks, utilization_bound, task_upper_bound, utilization_array);
+}
+
 /**************** Generate a random taskset ********************/ 
 /* Params: number_gpu_tasks: number of tasks with gpu sections
 		   max_gpu_segments: maximum GPU segments per task 
 		   random_flag: if 1 set randomly, if not set to value
-		   per_task_gpu_segments: vector of gpu task segments per task */
-int generate_random_num_gpu_segments(int number_gpu_tasks, int max_gpu_segments, int random_flag, std::vector<int> &per_task_gpu_segments)
+		   per_task_gpu_segments: gpu task segments per task (number_gpu_tasks of them) */
+int generate_random_num_gpu_segments(int number_gpu_tasks, int max_gpu_segments, int random_flag, int *per_task_gpu_segments)
 {
 	int i, random, total_segments = 0;
-	for (i = 0; i < per_task_gpu_segments.size(); i++)
+	for (i = 0; i < number_gpu_tasks; i++)
 	{
-		random = rand();
+		random = taskset_rand();
 		if (max_gpu_segments > 1 && random_flag)
 			per_task_gpu_segments[i] = (random % (max_gpu_segments - 1)) + 1;
 		else if (max_gpu_segments > 1)
@@ -109,119 +449,238 @@ int generate_random_num_gpu_segments(int number_gpu_tasks, int max_gpu_segments,
 	return total_segments;
 }
 
-/**************** Generate a random taskset ********************/ 
-/* Params: number_tasks: number of tasks
-		   number_gpu_tasks: number of tasks with gpu sections
-		   max_gpu_segments: maximum GPU segments per task
-           utilization bound: taskset utilization desired
-           gpu_utilization_bound: taskset utilization gpu bound 
-           harmonic_flag: true indicates harmonic period
-           gpu_seg_random_flag: true indicates generate number of per task gpu segments randomly using max
-   		   max_gpu_fraction: maximum fraction of the GPU that a gpu request consumes
-   Returns: Vector of Tasks, empty vector in case of error */
-std::vector<Task> generate_tasks(int number_tasks, int number_gpu_tasks, int max_gpu_segments, double utilization_bound, double gpu_utilization_bound, int harmonic_flag, int gpu_seg_random_flag, double max_gpu_fraction)
+/**************** Empty a taskset arena ********************/ 
+void clear_taskset_arena(taskset_arena_t &arena)
+{
+	arena.num_tasksets = 0;
+	arena.first_task.assign(1, 0);
+	arena.C.clear();
+	arena.D.clear();
+	arena.T.clear();
+	arena.first_segment.assign(1, 0);
+	arena.Gm.clear();
+	arena.Ge.clear();
+	arena.F.clear();
+}
+
+/**************** Generate a random taskset into an arena ********************/ 
+int generate_tasks_into(taskset_arena_t &arena, int number_tasks, int number_gpu_tasks, int max_gpu_segments, double utilization_bound, 
+						double gpu_utilization_bound, int harmonic_flag, int gpu_seg_random_flag, double max_gpu_fraction)
 {
-	int min_period = MIN_PERIOD;					        // in ms
-	int max_period = MAX_PERIOD;							// in ms
-	double cpu_task_upper_bound = CPU_TASK_UPPER_BOUND;  
-	double gpu_task_upper_bound = GPU_TASK_UPPER_BOUND;  
-	double cpu_intervention_util = CPU_INTERVENTION_UTIL;
-	double cpu_intervention_bound = CPU_INTERVENTION_BOUND;         
+	const sched_config_t &config = get_sched_config();
+	int min_period = config.min_period;					    // in ms
+	int max_period = config.max_period;						// in ms
+	double cpu_task_upper_bound = config.cpu_task_upper_bound;  
+	double gpu_task_upper_bound = config.gpu_task_upper_bound;  
+	double cpu_intervention_util = config.cpu_intervention_util;
+	double cpu_intervention_bound = config.cpu_intervention_bound;         
+	int gpu_fraction_granularity = config.gpu_fraction_granularity;
            
 	int i = 0;
 	int random;
-	gpu_params_t G;
+	double T = 0, Gm, Ge, F;
 
 	int total_gpu_segments; // total number of GPU segments
-	std::vector<int> per_task_gpu_segments(number_gpu_tasks, 1);
+	if (arena.first_task.empty())
+		clear_taskset_arena(arena);
 
 	// Get the total number of GPU segments
-	total_gpu_segments = generate_random_num_gpu_segments(number_gpu_tasks, max_gpu_segments, gpu_seg_random_flag, per_task_gpu_segments);
-
-	// Generate utilization arrays
-	std::vector<double> utilization_array(number_tasks, 0.0);
-	std::vector<double> gpu_utilization_array(total_gpu_segments, 0.0);
-	std::vector<Task> task_vector;
-	task_t task_params;
+	arena.per_task_gpu_segments.resize(std::max(number_gpu_tasks, 0));
+	total_gpu_segments = generate_random_num_gpu_segments(number_gpu_tasks, max_gpu_segments, gpu_seg_random_flag, 
+														  arena.per_task_gpu_segments.data());
 
 	// Check if number of tasks with GPU sections is less than total number of tasks
 	if (number_gpu_tasks > number_tasks || number_tasks <= 0)
-		return task_vector;
-	
-	// Generate CPU utilization array using UUniFast-Discard
-	if(UUniFast(number_tasks, utilization_bound, cpu_task_upper_bound, utilization_array))
+		return -1;
+	if (harmonic_flag == 2 && divisor_periods().empty())
+		return -1;
+
+	// Generate CPU utilization array
+	arena.utilization.assign(number_tasks, 0.0);
+	if(draw_utilizations(number_tasks, utilization_bound, cpu_task_upper_bound, arena.utilization.data(), arena))
 	{
-		return task_vector;
+		return -1;
 	}
 
 	if (number_gpu_tasks > 0)
 	{
-		// Generate GPU utilization array using UUniFast-Discard
-		if(UUniFast(total_gpu_segments, gpu_utilization_bound, gpu_task_upper_bound, gpu_utilization_array))
+		// Generate GPU utilization array
+		arena.gpu_utilization.assign(total_gpu_segments, 0.0);
+		if(draw_utilizations(total_gpu_segments, gpu_utilization_bound, gpu_task_upper_bound, arena.gpu_utilization.data(), arena))
 		{
-			return task_vector;
+			return -1;
 		}
 	}
 
 	while(i < number_tasks)
 	{
 		// Randomly Initialize Time Periods
-		random = rand();
+		random = taskset_rand();
 		if(harmonic_flag == 1 && i == 0)
 		{
-			task_params.T = (random % (min_period)) + min_period;
+			T = (random % (min_period)) + min_period;
 		}
 		else if(harmonic_flag == 1 && i > 0)
 		{
-			task_params.T = ((random % (3)) + 1)*task_params.T;
+			T = ((random % (3)) + 1)*T;
+		}
+		else if(harmonic_flag == 2)
+		{
+			T = draw_divisor_period(random);
 		}
 		else
 		{
-			task_params.T = (random % (max_period-min_period)) + min_period;
+			T = (random % (max_period-min_period)) + min_period;
 		}
 
-		// Set the deadline to be implicit
-		task_params.D = task_params.T;
-
-		// Set the CPU computation time based on UUniFast
-		task_params.C = utilization_array[i]*task_params.T;
-
-		// Clear the gpu param vector
-		task_params.G.clear();
+		// Set the deadline to be implicit, the CPU computation time based on UUniFast
+		arena.T.push_back(T);
+		arena.D.push_back(T);
+		arena.C.push_back(arena.utilization[i]*T);
 
 		// Set the GPU computation time
 		if (i < number_gpu_tasks)
 		{
 			// Set the parameters
-			for (int j = 0; j < per_task_gpu_segments[i]; j++)
+			for (int j = 0; j < arena.per_task_gpu_segments[i]; j++)
 			{
-				G.Ge = gpu_utilization_array[j]*task_params.T;
-				if (cpu_intervention_util*G.Ge < cpu_intervention_bound)
+				Ge = arena.gpu_utilization[j]*T;
+				if (cpu_intervention_util*Ge < cpu_intervention_bound)
 				{
-					G.Gm = cpu_intervention_util*G.Ge;
-					G.Ge = G.Ge - G.Gm;
+					Gm = cpu_intervention_util*Ge;
+					Ge = Ge - Gm;
 				}
 				else
 				{
-					G.Gm = cpu_intervention_bound;
-					G.Ge = G.Ge - cpu_intervention_bound;
+					Gm = cpu_intervention_bound;
+					Ge = Ge - cpu_intervention_bound;
 				}
-				random = rand();
-				G.F = ((double) ((random % (GPU_FRACTION_GRANULARITY - 1)) + 1))/GPU_FRACTION_GRANULARITY;
+				random = taskset_rand();
+				F = ((double) ((random % (gpu_fraction_granularity - 1)) + 1))/gpu_fraction_granularity;
 				// Floor the fraction at the max gpu fraction
-				if (G.F > max_gpu_fraction)
-					G.F = max_gpu_fraction;
+				if (F > max_gpu_fraction)
+					F = max_gpu_fraction;
 
-				task_params.G.push_back(G);
+				arena.Gm.push_back(Gm);
+				arena.Ge.push_back(Ge);
+				arena.F.push_back(F);
 			}
-			
 		}
-
-		// Create the task class
-		Task task(task_params);
-		task_vector.push_back(task);
+		arena.first_segment.push_back(arena.Gm.size());
 
 		i++;
 	}
+
+	arena.first_task.push_back(arena.T.size());
+	arena.num_tasksets++;
+	return 0;
+}
+
+/**************** Generate a batch of random tasksets into an arena ********************/ 
+int generate_taskset_batch(taskset_arena_t &arena, int num_tasksets, int max_number_tasks, int random_number_tasks, 
+						   double gpu_task_fraction, int max_gpu_segments, double utilization_bound, double gpu_utilization_bound, 
+						   int harmonic_flag, int gpu_seg_random_flag, double max_gpu_fraction, 
+						   unsigned int stream_seed, unsigned int first_index)
+{
+	int number_tasks, number_gpu_tasks;
+	int attempts = 0;
+	int max_attempts = 1000;	// per taskset, a parameter set nothing can be generated for
+	int stream = -1;
+
+	clear_taskset_arena(arena);
+	while ((int) arena.num_tasksets < num_tasksets && attempts < max_attempts)
+	{
+		// Redraws of a failed taskset continue its stream
+		if (stream_seed != 0 && stream != (int) arena.num_tasksets)
+		{
+			stream = arena.num_tasksets;
+			seed_taskset_stream(stream_seed, first_index + stream);
+		}
+
+		if (random_number_tasks)
+		{
+			number_tasks = (taskset_rand() % max_number_tasks) + 1;
+			number_gpu_tasks = ceil(gpu_task_fraction*number_tasks);
+		}
+		else
+		{
+			number_tasks = max_number_tasks;
+			number_gpu_tasks = floor(gpu_task_fraction*number_tasks);
+		}
+
+		if (generate_tasks_into(arena, number_tasks, number_gpu_tasks, max_gpu_segments, utilization_bound, gpu_utilization_bound, 
+								harmonic_flag, gpu_seg_random_flag, max_gpu_fraction) == 0)
+			attempts = 0;
+		else
+			attempts++;
+	}
+	return arena.num_tasksets;
+}
+
+/**************** Copy a taskset of an arena into the analysis container ********************/ 
+void materialize_taskset(const taskset_arena_t &arena, unsigned int index, std::vector<Task> &task_vector)
+{
+	static thread_local task_t task_params;				// keeps the capacity of its segments
+	static thread_local std::vector<Task> spare_tasks;		// dropped by a smaller taskset, reused by a larger one
+	unsigned int num_tasks = arena.first_task[index + 1] - arena.first_task[index];
+	gpu_params_t G;
+
+	while (task_vector.size() > num_tasks)
+	{
+		spare_tasks.push_back(std::move(task_vector.back()));
+		task_vector.pop_back();
+	}
+	for (unsigned int k = 0; k < num_tasks; k++)
+	{
+		unsigned int i = arena.first_task[index] + k;
+		task_params.C = arena.C[i];
+		task_params.D = arena.D[i];
+		task_params.T = arena.T[i];
+		task_params.G.clear();
+		for (unsigned int j = arena.first_segment[i]; j < arena.first_segment[i + 1]; j++)
+		{
+			G.Gm = arena.Gm[j];
+			G.Ge = arena.Ge[j];
+			G.F = arena.F[j];
+			task_params.G.push_back(G);
+		}
+		if (k < task_vector.size())
+			task_vector[k].setParams(task_params);
+		else if (!spare_tasks.empty())
+		{
+			task_vector.push_back(std::move(spare_tasks.back()));
+			spare_tasks.pop_back();
+			task_vector.back().setParams(task_params);
+		}
+		else
+			task_vector.push_back(Task(task_params));
+	}
+}
+
+int generate_tasks_in_place(taskset_arena_t &arena, std::vector<Task> &task_vector, int number_tasks, int number_gpu_tasks, 
+							int max_gpu_segments, double utilization_bound, double gpu_utilization_bound, int harmonic_flag, 
+							int gpu_seg_random_flag, double max_gpu_fraction)
+{
+	clear_taskset_arena(arena);
+	if (generate_tasks_into(arena, number_tasks, number_gpu_tasks, max_gpu_segments, utilization_bound, gpu_utilization_bound, 
+							harmonic_flag, gpu_seg_random_flag, max_gpu_fraction) != 0)
+	{
+		task_vector.clear();
+		return -1;
+	}
+	materialize_taskset(arena, 0, task_vector);
+	return 0;
+}
+
+/**************** Generate a random taskset ********************/ 
+/* Params: see generate_tasks_into, the taskset is generated into the calling thread's arena
+   Returns: Vector of Tasks, empty vector in case of error */
+std::vector<Task> generate_tasks(int number_tasks, int number_gpu_tasks, int max_gpu_segments, double utilization_bound, double gpu_utilization_bound, int harmonic_flag, int gpu_seg_random_flag, double max_gpu_fraction)
+{
+	static thread_local taskset_arena_t arena;
+	std::vector<Task> task_vector;
+
+	generate_tasks_in_place(arena, task_vector, number_tasks, number_gpu_tasks, max_gpu_segments, utilization_bound, 
+							gpu_utilization_bound, harmonic_flag, gpu_seg_random_flag, max_gpu_fraction);
 	return task_vector;
-}
\ No newline at end of file
+}
@@ -29,17 +29,125 @@
 #define TASKGEN_HPP
 
 #include <vector>
+#include <string>
+#include <cstdint>
 
 #include "task.hpp"
 #include "config.hpp"
 
+/**************** Seed the calling thread's taskset generator ********************/ 
+/* Params: seed: seed of the thread's own engine, used instead of rand() from then on */
+void seed_taskset_generator(unsigned int seed);
+
+/**************** Seed the calling thread's taskset generator for one taskset of a sweep (common random numbers) ********************/ 
+/* The taskset with the same index gets the same random draws at every sweep point: its structure (periods, segments, fractions)
+   and the normalized shape of its utilizations come from separate engines, the shape is rescaled to each point's bound
+   Params: base_seed: seed shared by the points of the sweep
+		   index    : index of the taskset within the point */
+void seed_taskset_stream(unsigned int base_seed, unsigned int index);
+
+/**************** Set the hyperperiod cap of divisor-rich periods ********************/ 
+/* With harmonic flag 2 the periods are the divisors within the configured period range of the number of the form 2^a 3^b 5^c 7^d
+   not above the cap with the most such divisors, so the hyperperiod of any taskset divides that number; to be called before
+   tasksets are generated (the set is shared by the generator threads), sets hyperperiod_cap of the runtime configuration
+   Params: cap: upper bound on the hyperperiod (HYPERPERIOD_CAP by default)
+   Returns: number of periods to draw from, 0 if no period fits under the cap */
+int set_hyperperiod_cap(uint64_t cap);
+
+/**************** Save and restore the calling thread's taskset generator ********************/ 
+/* Params: state: textual state of the thread's engine (populated by get_taskset_generator_state)
+   Returns: 0 on success, -1 if the thread draws from rand() (no state to save) or the state is malformed */
+int get_taskset_generator_state(std::string &state);
+int set_taskset_generator_state(const std::string &state);
+
+/**************** Draw a random number for taskset generation ********************/ 
+/* Returns: a number in [0, RAND_MAX], from the thread's engine if seeded, from rand() otherwise */
+int taskset_rand();
+
+/**************** Get the utilization sampler statistics ********************/ 
+/* Params: draws: utilization vectors drawn
+		   discards: drawn vectors discarded because a task exceeded its upper bound
+		   failures: calls that gave up (empty taskset returned) */
+void get_util_sampler_stats(long &draws, long &discards, long &failures);
+
+/**************** Tasksets in a flat (structure of arrays) layout ********************/ 
+/* Taskset k holds the tasks [first_task[k], first_task[k+1]) and task i the GPU segments [first_segment[i], first_segment[i+1]),
+   the columns and the sampler scratch keep their capacity across clear_taskset_arena, so a reused arena stops allocating
+   once it has held its largest taskset */
+typedef struct taskset_arena
+{
+	unsigned int num_tasksets;
+	std::vector<unsigned int> first_task;
+	std::vector<double> C;
+	std::vector<double> D;
+	std::vector<double> T;
+	std::vector<unsigned int> first_segment;
+	std::vector<double> Gm;
+	std::vector<double> Ge;
+	std::vector<double> F;
+
+	// Sampler scratch
+	std::vector<int> per_task_gpu_segments;
+	std::vector<double> utilization;
+	std::vector<double> gpu_utilization;
+	std::vector<double> random;
+	std::vector<double> s1;
+	std::vector<double> s2;
+	std::vector<double> w;
+	std::vector<double> t;
+} taskset_arena_t;
+
+/**************** Empty a taskset arena ********************/ 
+void clear_taskset_arena(taskset_arena_t &arena);
+
+/**************** Generate a random taskset into an arena ********************/ 
+/* Params: arena: the taskset is appended to it, nothing is appended in case of error
+		   others: see generate_tasks
+   Returns: 0 on success, -1 in case of error */
+int generate_tasks_into(taskset_arena_t &arena, int number_tasks, int number_gpu_tasks, int max_gpu_segments, double utilization_bound, 
+						double gpu_utilization_bound, int harmonic_flag, int gpu_seg_random_flag, double max_gpu_fraction);
+
+/**************** Generate a batch of random tasksets into an arena ********************/ 
+/* The number of tasks (and of GPU tasks) of each taskset is chosen as in the experiment drivers, failed draws are redrawn
+   Params: arena: cleared, then filled with the tasksets
+		   num_tasksets: tasksets to generate
+		   max_number_tasks: number of tasks, or its maximum if random_number_tasks
+		   random_number_tasks: if 1 the number of tasks is drawn in [1, max_number_tasks]
+		   gpu_task_fraction: fraction of the tasks with gpu sections
+		   stream_seed: if not 0, taskset k is drawn from seed_taskset_stream(stream_seed, first_index + k), as the drivers
+						draw that taskset one at a time; otherwise from the calling thread's generator
+		   first_index: index of the first taskset of the batch within the sweep point
+		   others: see generate_tasks
+   Returns: the number of tasksets generated, less than num_tasksets if the parameters keep failing */
+int generate_taskset_batch(taskset_arena_t &arena, int num_tasksets, int max_number_tasks, int random_number_tasks, 
+						   double gpu_task_fraction, int max_gpu_segments, double utilization_bound, double gpu_utilization_bound, 
+						   int harmonic_flag, int gpu_seg_random_flag, double max_gpu_fraction, 
+						   unsigned int stream_seed, unsigned int first_index);
+
+/**************** Copy a taskset of an arena into the analysis container ********************/ 
+/* The tasks already in task_vector are reset in place, the tasks it drops are kept by the calling thread for a
+   later larger taskset, so tasks are only constructed when the thread has never held that many
+   Params: index: taskset within the arena
+		   task_vector: replaced by the tasks of the taskset */
+void materialize_taskset(const taskset_arena_t &arena, unsigned int index, std::vector<Task> &task_vector);
+
+/**************** Generate a random taskset into reused containers ********************/ 
+/* Generating into the same arena and task_vector stops allocating once they have held the largest taskset
+   Params: arena: cleared, then holds the taskset
+		   task_vector: replaced by the tasks of the taskset, emptied in case of error
+		   others: see generate_tasks
+   Returns: 0 on success, -1 in case of error */
+int generate_tasks_in_place(taskset_arena_t &arena, std::vector<Task> &task_vector, int number_tasks, int number_gpu_tasks, 
+							int max_gpu_segments, double utilization_bound, double gpu_utilization_bound, int harmonic_flag, 
+							int gpu_seg_random_flag, double max_gpu_fraction);
+
 /**************** Generate a random taskset ********************/ 
 /* Params: number_tasks: number of tasks
 		   number_gpu_tasks: number of tasks with gpu sections
 		   max_gpu_segments: maximum GPU segments per task
            utilization bound: taskset utilization desired
            gpu_utilization_bound: taskset utilization gpu bound 
-           harmonic_flag: true indicates harmonic period
+           harmonic_flag: 1 indicates harmonic periods, 2 divisor-rich periods with a bounded hyperperiod
            gpu_seg_random_flag: true indicates generate number of per task gpu segments randomly using max
    		   max_gpu_fraction: maximum fraction of the GPU that a gpu request consumes
    Returns: Vector of Tasks, empty vector in case of error */
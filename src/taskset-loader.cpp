@@ -0,0 +1,188 @@
+/*
+ * @file taskset-loader.cpp
+ * @brief Streaming CSV taskset loader implementation
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+
+// Include Internal Headers
+#include "taskset-loader.hpp"
+
+/**************** Trim the whitespace around a field ********************/ 
+static std::string trim_field(const std::string &field)
+{
+	size_t first = field.find_first_not_of(" \t\r");
+	if (first == std::string::npos)
+		return "";
+	size_t last = field.find_last_not_of(" \t\r");
+	return field.substr(first, last - first + 1);
+}
+
+/**************** Parse a finite number, the whole field has to be consumed ********************/ 
+static int parse_number(const std::string &field, double &value)
+{
+	std::string trimmed = trim_field(field);
+	char *end;
+
+	if (trimmed.empty())
+		return -1;
+	value = std::strtod(trimmed.c_str(), &end);
+	if (*end != '\0' || !std::isfinite(value))
+		return -1;
+	return 0;
+}
+
+TasksetLoader::TasksetLoader()
+{
+	line_number = 0;
+	pending = false;
+}
+
+TasksetLoader::~TasksetLoader()
+{
+	close();
+}
+
+int TasksetLoader::open(const std::string &name)
+{
+	close();
+	filename = name;
+	infile.open(filename);
+	if (!infile)
+	{
+		std::cerr << "Loader: cannot read " << filename << "\n";
+		return -1;
+	}
+	return 0;
+}
+
+void TasksetLoader::close()
+{
+	if (infile.is_open())
+		infile.close();
+	infile.clear();
+	line_number = 0;
+	pending = false;
+}
+
+unsigned long TasksetLoader::getLineNumber() const
+{
+	return line_number;
+}
+
+int TasksetLoader::parseLine(const std::string &line, std::string &name, task_t &task_params) const
+{
+	std::vector<double> values;
+	std::stringstream stream(line);
+	std::string field;
+	gpu_params_t G;
+	double value;
+
+	if (!std::getline(stream, field, ','))
+		return -1;
+	name = trim_field(field);
+
+	while (std::getline(stream, field, ','))
+	{
+		if (parse_number(field, value) != 0)
+			return -1;
+		values.push_back(value);
+	}
+
+	// C, D, T and whole GPU segments
+	if (values.size() < 3 || (values.size() - 3) % 3 != 0)
+		return -1;
+
+	task_params.C = values[0];
+	task_params.D = values[1];
+	task_params.T = values[2];
+	if (task_params.C < 0 || task_params.T <= 0 || task_params.D <= 0 || task_params.D > task_params.T)
+		return -1;
+
+	task_params.G.clear();
+	for (unsigned int index = 3; index < values.size(); index += 3)
+	{
+		G.Gm = values[index];
+		G.Ge = values[index + 1];
+		G.F = values[index + 2];
+		if (G.Gm < 0 || G.Ge < 0 || G.F <= 0 || G.F > 1)
+			return -1;
+		task_params.G.push_back(G);
+	}
+	return 0;
+}
+
+int TasksetLoader::next(std::vector<Task> &task_vector, std::string &name)
+{
+	std::string line, line_name;
+	task_t task_params;
+
+	task_vector.clear();
+	name.clear();
+
+	// The first task of this taskset ended the previous one
+	if (pending)
+	{
+		name = pending_name;
+		task_vector.push_back(Task(pending_params));
+		pending = false;
+	}
+
+	while (std::getline(infile, line))
+	{
+		line_number++;
+		std::string trimmed = trim_field(line);
+		if (trimmed.empty() || trimmed[0] == '#')
+			continue;
+
+		if (parseLine(trimmed, line_name, task_params) != 0)
+		{
+			std::cerr << "Loader: " << filename << ":" << line_number << ": malformed task \"" << trimmed << "\"\n";
+			task_vector.clear();
+			return -1;
+		}
+
+		if (!task_vector.empty() && line_name != name)
+		{
+			pending = true;
+			pending_name = line_name;
+			pending_params = task_params;
+			return 1;
+		}
+
+		name = line_name;
+		task_vector.push_back(Task(task_params));
+	}
+
+	if (task_vector.empty())
+		return 0;
+	return 1;
+}
@@ -0,0 +1,68 @@
+/*
+ * @file taskset-loader.hpp
+ * @brief Streaming CSV taskset loader header
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TASKSET_LOADER_HPP
+#define TASKSET_LOADER_HPP
+
+#include <fstream>
+#include <vector>
+#include <string>
+
+#include "task.hpp"
+
+/* Taskset description (CSV), one task per line:
+   	<taskset>,C,D,T[,Gm,Ge,F]*
+   consecutive lines with the same taskset name form a taskset, blank lines and lines starting with '#' are skipped */
+class TasksetLoader
+{
+	// Constructor and destructor
+	public: TasksetLoader();
+	public: ~TasksetLoader();
+
+	// Open a taskset description, 0 on success
+	public: int open(const std::string &filename);
+	public: void close();
+
+	// Read the next taskset (in file order), the file is read one line at a time
+	/* Returns: 1 if a taskset was read, 0 at the end of the file, -1 on a malformed line (reported with its line number) */
+	public: int next(std::vector<Task> &task_vector, std::string &name);
+
+	public: unsigned long getLineNumber() const;
+
+	// Parse one task line, 0 on success
+	private: int parseLine(const std::string &line, std::string &name, task_t &task_params) const;
+
+	// Private Variables
+	private: std::ifstream infile;
+	private: std::string filename;
+	private: unsigned long line_number;
+	private: bool pending;				// a task of the next taskset has already been read
+	private: std::string pending_name;
+	private: task_t pending_params;
+};
+
+#endif
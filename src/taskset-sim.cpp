@@ -0,0 +1,707 @@
+/*
+ * @file taskset-sim.cpp
+ * @brief Discrete-event simulator of the multicore system with a concurrent GPU
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Standard Library Imports */
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <atomic>
+
+/* Internal Headers */
+#include "taskset-sim.hpp"
+#include "hyperperiod.hpp"
+
+// Event kinds, in the order they are processed at the same instant
+#define SIM_EVENT_CPU_DONE 0
+#define SIM_EVENT_GPU_DONE 1
+#define SIM_EVENT_RELEASE  2
+
+// Kinds of the phases of a job, phase 4s + kind for GPU segment s (4n is the last CPU chunk)
+#define SIM_PHASE_CPU      0
+#define SIM_PHASE_LAUNCH   1
+#define SIM_PHASE_GPU      2
+#define SIM_PHASE_COMPLETE 3
+
+// Slack on time and GPU share comparisons (floating point errors)
+#define SIM_EPSILON 1e-9
+
+// Heap order of the events -> earliest first
+struct CompareSimEvent {
+	bool operator()(sim_event_t const & e1, sim_event_t const & e2) {
+		if (e1.time != e2.time)
+			return e1.time > e2.time;
+		if (e1.kind != e2.kind)
+			return e1.kind > e2.kind;
+		return e1.seq > e2.seq;
+	}
+} CompareEventTime;
+
+// Constructor
+TasksetSimulator::TasksetSimulator(const std::vector<Task> &task_vector, const sim_params_t &sim_params) : tasks(task_vector)
+{
+	params = sim_params;
+	num_cores = 1;
+	for (unsigned int index = 0; index < tasks.size(); index++)
+		num_cores = std::max(num_cores, tasks[index].getCoreID() + 1);
+	mask_words = (tasks.size() + 63)/64;
+	gpu_used = 0;
+	event_seq = 0;
+	stats = NULL;
+	trace = NULL;
+	exec_engine.seed(params.seed);
+
+	task_state.resize(tasks.size());
+	for (unsigned int index = 0; index < tasks.size(); index++)
+	{
+		sim_task_state_t &state = task_state[index];
+		unsigned int num_gpu_segments = tasks[index].getNumGPUSegments();
+		state.core = tasks[index].getCoreID();
+		state.num_phases = 4*num_gpu_segments + 1;
+		state.cpu_chunk = tasks[index].getC()/(num_gpu_segments + 1);
+		state.tail = -1;
+		state.active = false;
+		state.release = 0;
+		state.phase = 0;
+		state.remaining = 0;
+		state.granted = false;
+		state.gm_exec = 0;
+		state.gpu_start = 0;
+		state.gpu_lane = 0;
+		state.flow_to_gpu = 0;
+		state.flow_from_gpu = 0;
+
+		// Pair a split head with its tail
+		if (tasks[index].getSplitPart() != SPLIT_HEAD)
+			continue;
+		for (unsigned int i = 0; i < tasks.size(); i++)
+		{
+			if (tasks[i].getSplitPart() == SPLIT_TAIL && tasks[i].getSplitID() == tasks[index].getSplitID())
+				state.tail = i;
+		}
+	}
+
+	core_state.resize(num_cores);
+	for (unsigned int core = 0; core < num_cores; core++)
+	{
+		core_state[core].running = -1;
+		core_state[core].last_update = 0;
+		core_state[core].stamp = 0;
+		core_state[core].slice_start = 0;
+	}
+	normal_ready.assign(num_cores*mask_words, 0);
+	boosted_ready.assign(num_cores*mask_words, 0);
+	core_dirty.assign(num_cores, false);
+	dirty_cores.reserve(num_cores);
+	gpu_waiting.reserve(tasks.size());
+	events.reserve(2*tasks.size() + 1);
+}
+
+// Destructor
+TasksetSimulator::~TasksetSimulator()
+{
+	return;
+}
+
+/**************** Event queue ********************/ 
+void TasksetSimulator::pushEvent(double time, int kind, unsigned int id, uint64_t stamp)
+{
+	sim_event_t event;
+	event.time = time;
+	event.kind = kind;
+	event.id = id;
+	event.stamp = stamp;
+	event.seq = event_seq++;
+	events.push_back(event);
+	std::push_heap(events.begin(), events.end(), CompareEventTime);
+}
+
+sim_event_t TasksetSimulator::popEvent()
+{
+	std::pop_heap(events.begin(), events.end(), CompareEventTime);
+	sim_event_t event = events.back();
+	events.pop_back();
+	return event;
+}
+
+/**************** Ready sets ********************/ 
+void TasksetSimulator::setReady(unsigned int task, bool boosted)
+{
+	unsigned int core = task_state[task].core;
+	std::vector<uint64_t> &mask = boosted ? boosted_ready : normal_ready;
+
+	mask[core*mask_words + task/64] |= (uint64_t) 1 << (task % 64);
+	if (!core_dirty[core])
+	{
+		core_dirty[core] = true;
+		dirty_cores.push_back(core);
+	}
+}
+
+void TasksetSimulator::clearReady(unsigned int task)
+{
+	unsigned int core = task_state[task].core;
+
+	normal_ready[core*mask_words + task/64] &= ~((uint64_t) 1 << (task % 64));
+	boosted_ready[core*mask_words + task/64] &= ~((uint64_t) 1 << (task % 64));
+}
+
+int TasksetSimulator::pickTask(unsigned int core) const
+{
+	for (unsigned int word = 0; word < mask_words; word++)
+	{
+		if (boosted_ready[core*mask_words + word] != 0)
+			return word*64 + __builtin_ctzll(boosted_ready[core*mask_words + word]);
+	}
+	for (unsigned int word = 0; word < mask_words; word++)
+	{
+		if (normal_ready[core*mask_words + word] != 0)
+			return word*64 + __builtin_ctzll(normal_ready[core*mask_words + word]);
+	}
+	return -1;
+}
+
+/**************** Run the highest-priority ready task of a core ********************/ 
+void TasksetSimulator::dispatch(unsigned int core, double now)
+{
+	sim_core_state_t &state = core_state[core];
+	int next;
+
+	// Charge the running task for the time since the last dispatch
+	if (state.running >= 0)
+		task_state[state.running].remaining -= now - state.last_update;
+	state.last_update = now;
+
+	// The completion event of a task that keeps running stays valid
+	next = pickTask(core);
+	if (next == state.running)
+		return;
+
+	traceSlice(core, now, false);
+	state.stamp++;
+	state.running = next;
+	state.slice_start = now;
+	if (next >= 0)
+		pushEvent(now + std::max(task_state[next].remaining, 0.0), SIM_EVENT_CPU_DONE, core, state.stamp);
+}
+
+/**************** Trace the execution on a core ********************/ 
+void TasksetSimulator::traceSlice(unsigned int core, double now, bool completes)
+{
+	sim_core_state_t &state = core_state[core];
+	uint64_t flow_in = 0, flow_out = 0;
+
+	if (trace == NULL || state.running < 0 || now <= state.slice_start)
+		return;
+
+	// The completion continues the flow of the GPU execution, a completed launch starts one
+	sim_task_state_t &task = task_state[state.running];
+	if (task.phase % 4 == SIM_PHASE_COMPLETE)
+	{
+		flow_in = task.flow_from_gpu;
+		task.flow_from_gpu = 0;
+	}
+	else if (task.phase % 4 == SIM_PHASE_LAUNCH && completes && tasks[state.running].getGe(task.phase/4) > 0)
+	{
+		flow_out = trace->newFlow();
+		task.flow_to_gpu = flow_out;
+	}
+	trace->cpuSlice(core, state.running, state.slice_start, now, task.phase % 4 != SIM_PHASE_CPU, flow_in, flow_out);
+}
+
+void TasksetSimulator::setTrace(SimTraceWriter *trace_writer)
+{
+	trace = trace_writer;
+}
+
+/**************** GPU sharing ********************/ 
+double TasksetSimulator::getFraction(unsigned int task, unsigned int segment) const
+{
+	if (!params.concurrent)
+		return 1;
+	return tasks[task].getF(segment);
+}
+
+bool TasksetSimulator::requestGPU(unsigned int task, double now)
+{
+	double fraction = getFraction(task, task_state[task].phase/4);
+
+	// The waiting requests do not fit, so a request that fits is served at once unless FIFO queues it behind them
+	bool queued_behind = (params.gpu_policy == SIM_GPU_FIFO && !gpu_waiting.empty());
+
+	if (!queued_behind && gpu_used + fraction <= 1 + SIM_EPSILON)
+	{
+		gpu_used = gpu_used + fraction;
+		task_state[task].granted = true;
+		if (trace != NULL)
+			trace->gpuShare(now, gpu_used);
+		return true;
+	}
+
+	gpu_waiting.push_back(task);
+	return false;
+}
+
+void TasksetSimulator::releaseGPU(unsigned int task, double now)
+{
+	int chosen;
+
+	gpu_used = std::max(gpu_used - getFraction(task, task_state[task].phase/4), 0.0);
+	task_state[task].granted = false;
+
+	// Grant the waiting requests one at a time, a grant may itself complete a segment and release the GPU again
+	while (true)
+	{
+		chosen = -1;
+		for (unsigned int i = 0; i < gpu_waiting.size(); i++)
+		{
+			unsigned int waiting = gpu_waiting[i];
+			bool fits = gpu_used + getFraction(waiting, task_state[waiting].phase/4) <= 1 + SIM_EPSILON;
+			if (params.gpu_policy == SIM_GPU_FIFO)
+			{
+				chosen = fits ? i : -1;
+				break;
+			}
+			if (fits && (chosen < 0 || waiting < gpu_waiting[chosen]))
+				chosen = i;
+		}
+		if (chosen < 0)
+			break;
+
+		unsigned int granted = gpu_waiting[chosen];
+		gpu_waiting.erase(gpu_waiting.begin() + chosen);
+		gpu_used = gpu_used + getFraction(granted, task_state[granted].phase/4);
+		task_state[granted].granted = true;
+		enterPhase(granted, now);
+	}
+	if (trace != NULL)
+		trace->gpuShare(now, gpu_used);
+}
+
+/**************** Execution time of a phase ********************/ 
+double TasksetSimulator::drawExec(double wcet)
+{
+	if (params.exec_model != SIM_EXEC_UNIFORM || wcet <= 0)
+		return wcet;
+	return wcet*(params.bcet_ratio + (1 - params.bcet_ratio)*((double) exec_engine()/((double) exec_engine.max() + 1)));
+}
+
+/**************** Job progress ********************/ 
+void TasksetSimulator::startJob(unsigned int task, double release, double now)
+{
+	sim_task_state_t &state = task_state[task];
+
+	state.active = true;
+	state.release = release;
+	state.phase = 0;
+	state.granted = false;
+	enterPhase(task, now);
+}
+
+/* Run the phases of the job from the current one until it has to execute or wait */
+void TasksetSimulator::enterPhase(unsigned int task, double now)
+{
+	sim_task_state_t &state = task_state[task];
+	unsigned int segment;
+
+	while (state.phase < state.num_phases)
+	{
+		segment = state.phase/4;
+		switch (state.phase % 4)
+		{
+			case SIM_PHASE_CPU:
+				state.remaining = drawExec(state.cpu_chunk);
+				if (state.remaining > 0)
+				{
+					setReady(task, false);
+					return;
+				}
+				break;
+
+			case SIM_PHASE_LAUNCH:
+				if (!state.granted && !requestGPU(task, now))
+					return;
+				state.gm_exec = drawExec(tasks[task].getGm(segment));
+				state.remaining = state.gm_exec/2;
+				if (state.remaining > 0)
+				{
+					setReady(task, true);
+					return;
+				}
+				break;
+
+			case SIM_PHASE_GPU:
+				if (tasks[task].getGe(segment) > 0)
+				{
+					if (trace != NULL)
+					{
+						state.gpu_lane = trace->acquireLane();
+						state.gpu_start = now;
+					}
+					pushEvent(now + drawExec(tasks[task].getGe(segment)), SIM_EVENT_GPU_DONE, task, 0);
+					return;
+				}
+				break;
+
+			case SIM_PHASE_COMPLETE:
+				state.remaining = state.gm_exec/2;
+				if (state.remaining > 0)
+				{
+					setReady(task, true);
+					return;
+				}
+				releaseGPU(task, now);
+				break;
+		}
+		state.phase++;
+	}
+	completeJob(task, now);
+}
+
+/* The current phase has executed entirely */
+void TasksetSimulator::finishPhase(unsigned int task, double now)
+{
+	sim_task_state_t &state = task_state[task];
+
+	clearReady(task);
+	if (state.phase % 4 == SIM_PHASE_COMPLETE)
+		releaseGPU(task, now);
+	state.phase++;
+	enterPhase(task, now);
+}
+
+void TasksetSimulator::completeJob(unsigned int task, double now)
+{
+	sim_task_state_t &state = task_state[task];
+	double resp_time = now - state.release;
+
+	stats->max_resp_time[task] = std::max(stats->max_resp_time[task], resp_time);
+	stats->num_jobs[task]++;
+	stats->total_jobs++;
+	if (resp_time > tasks[task].getD() + SIM_EPSILON)
+	{
+		stats->deadline_misses[task]++;
+		if (trace != NULL)
+			trace->deadlineMiss(state.core, task, state.release, now);
+	}
+	if (params.record_histogram)
+	{
+		unsigned int bucket = sim_histogram_bucket(resp_time);
+		if (bucket >= stats->resp_histogram[task].size())
+			stats->resp_histogram[task].resize(bucket + 1, 0);
+		stats->resp_histogram[task][bucket]++;
+	}
+	state.active = false;
+
+	// Release the tail of a split task
+	if (state.tail >= 0)
+	{
+		if (task_state[state.tail].active)
+			task_state[state.tail].backlog.push_back(now);
+		else
+			startJob(state.tail, now, now);
+	}
+
+	// Start the job released meanwhile, it has been waiting since its release
+	if (!state.backlog.empty())
+	{
+		double release = state.backlog.front();
+		state.backlog.pop_front();
+		startJob(task, release, now);
+	}
+}
+
+/**************** Simulate up to the horizon ********************/ 
+int TasksetSimulator::run(sim_stats_t &sim_stats)
+{
+	sim_event_t event;
+	uint64_t hyperperiod;
+
+	stats = &sim_stats;
+	stats->max_resp_time.assign(tasks.size(), 0);
+	stats->num_jobs.assign(tasks.size(), 0);
+	stats->deadline_misses.assign(tasks.size(), 0);
+	stats->resp_histogram.assign(params.record_histogram ? tasks.size() : 0, std::vector<long>());
+	stats->total_jobs = 0;
+	stats->num_events = 0;
+
+	for (unsigned int index = 0; index < tasks.size(); index++)
+	{
+		if (tasks[index].getT() <= 0)
+			return -1;
+	}
+
+	// The hyperperiod covers every release pattern of the synchronous periodic arrivals
+	stats->horizon = params.horizon;
+	if (stats->horizon <= 0)
+	{
+		hyperperiod = compute_hyperperiod(tasks, SIM_MAX_HORIZON);
+		stats->horizon = (hyperperiod > 0) ? hyperperiod : SIM_MAX_HORIZON;
+	}
+
+	// Synchronous release, the tails follow their heads
+	for (unsigned int index = 0; index < tasks.size(); index++)
+	{
+		if (tasks[index].getSplitPart() != SPLIT_TAIL)
+			pushEvent(0, SIM_EVENT_RELEASE, index, 0);
+	}
+
+	while (!events.empty())
+	{
+		event = popEvent();
+		stats->num_events++;
+
+		switch (event.kind)
+		{
+			case SIM_EVENT_CPU_DONE:
+			{
+				sim_core_state_t &state = core_state[event.id];
+				if (event.stamp != state.stamp || state.running < 0)
+					break;
+
+				// The core is idle until the next dispatch
+				unsigned int task = state.running;
+				traceSlice(event.id, event.time, true);
+				task_state[task].remaining = 0;
+				state.running = -1;
+				state.stamp++;
+				state.last_update = event.time;
+				if (!core_dirty[event.id])
+				{
+					core_dirty[event.id] = true;
+					dirty_cores.push_back(event.id);
+				}
+				finishPhase(task, event.time);
+				break;
+			}
+
+			case SIM_EVENT_GPU_DONE:
+				if (trace != NULL)
+				{
+					sim_task_state_t &state = task_state[event.id];
+					unsigned int segment = state.phase/4;
+					state.flow_from_gpu = (state.gm_exec > 0) ? trace->newFlow() : 0;
+					trace->gpuSlice(state.gpu_lane, event.id, segment, getFraction(event.id, segment), state.gpu_start, event.time,
+									state.flow_to_gpu, state.flow_from_gpu);
+					state.flow_to_gpu = 0;
+				}
+				finishPhase(event.id, event.time);
+				break;
+
+			case SIM_EVENT_RELEASE:
+				if (task_state[event.id].active)
+					task_state[event.id].backlog.push_back(event.time);
+				else
+					startJob(event.id, event.time, event.time);
+				if (event.time + tasks[event.id].getT() < stats->horizon)
+					pushEvent(event.time + tasks[event.id].getT(), SIM_EVENT_RELEASE, event.id, 0);
+				break;
+		}
+
+		// Reschedule the cores whose ready set changed
+		for (unsigned int i = 0; i < dirty_cores.size(); i++)
+		{
+			core_dirty[dirty_cores[i]] = false;
+			dispatch(dirty_cores[i], event.time);
+		}
+		dirty_cores.clear();
+	}
+
+	stats = NULL;
+	return 0;
+}
+
+/**************** Simulation parameters matching a schedulability test ********************/ 
+int get_sim_params(sched_type sched_mode, sim_params_t &params)
+{
+	params.horizon = 0;
+	params.gpu_policy = (sched_mode == FIFO_CONC) ? SIM_GPU_FIFO : SIM_GPU_PRIORITY;
+	params.concurrent = (sched_mode != REQUEST_DRIVEN && sched_mode != JOB_DRIVEN && sched_mode != HYBRID);
+	params.exec_model = SIM_EXEC_WCET;
+	params.bcet_ratio = SIM_BCET_RATIO;
+	params.seed = 0;
+	params.record_histogram = false;
+	if (sched_mode < REQUEST_DRIVEN || sched_mode >= INVALID)
+		return -1;
+	return 0;
+}
+
+/**************** Response-time histogram ********************/ 
+unsigned int sim_histogram_bucket(double resp_time)
+{
+	if (resp_time <= SIM_HISTOGRAM_FLOOR)
+		return 0;
+	return 1 + (unsigned int) floor(log(resp_time/SIM_HISTOGRAM_FLOOR)/log1p(SIM_HISTOGRAM_RESOLUTION));
+}
+
+double sim_histogram_upper_edge(unsigned int bucket)
+{
+	return SIM_HISTOGRAM_FLOOR*exp(bucket*log1p(SIM_HISTOGRAM_RESOLUTION));
+}
+
+double sim_histogram_percentile(const std::vector<long> &histogram, double percentile)
+{
+	long total = 0, count = 0;
+	long rank;
+
+	for (unsigned int bucket = 0; bucket < histogram.size(); bucket++)
+		total = total + histogram[bucket];
+	if (total == 0)
+		return 0;
+
+	// Nearest rank
+	rank = std::max((long) ceil(percentile*total), 1L);
+	for (unsigned int bucket = 0; bucket < histogram.size(); bucket++)
+	{
+		count = count + histogram[bucket];
+		if (count >= rank)
+			return sim_histogram_upper_edge(bucket);
+	}
+	return sim_histogram_upper_edge(histogram.size() - 1);
+}
+
+/**************** Simulate a partitioned taskset ********************/ 
+int simulate_taskset(const std::vector<Task> &task_vector, const sim_params_t &params, sim_stats_t &stats)
+{
+	TasksetSimulator simulator(task_vector, params);
+	return simulator.run(stats);
+}
+
+/**************** Simulate a partitioned taskset and trace its schedule ********************/ 
+int simulate_taskset_trace(const std::vector<Task> &task_vector, const sim_params_t &params, sim_stats_t &stats, 
+						   const std::string &trace_filename)
+{
+	TasksetSimulator simulator(task_vector, params);
+	SimTraceWriter trace;
+	unsigned int num_cores = 1;
+	int retval;
+
+	for (unsigned int index = 0; index < task_vector.size(); index++)
+		num_cores = std::max(num_cores, task_vector[index].getCoreID() + 1);
+	if (trace.open(trace_filename, num_cores) != 0)
+		return -1;
+
+	simulator.setTrace(&trace);
+	retval = simulator.run(stats);
+	if (trace.close() != 0)
+		return -1;
+	return retval;
+}
+
+/**************** Simulate a partitioned taskset with random execution times ********************/ 
+int simulate_taskset_monte_carlo(const std::vector<Task> &task_vector, const sim_params_t &params, int num_seeds, int num_threads,
+								 sim_distribution_t &distribution)
+{
+	std::vector<std::thread> threads;
+	std::vector<sim_stats_t> merged;		// one per thread, merged once they are joined
+	std::atomic<int> next_seed(0);
+	std::atomic<int> sim_error(0);
+	unsigned int num_tasks = task_vector.size();
+
+	if (num_threads <= 0)
+		num_threads = std::max(1u, std::thread::hardware_concurrency());
+	num_threads = std::max(std::min(num_threads, num_seeds), 1);
+	merged.resize(num_threads);
+
+	for (int t = 0; t < num_threads; t++)
+	{
+		threads.emplace_back([&, t]()
+		{
+			sim_params_t seed_params = params;
+			sim_stats_t stats;
+			sim_stats_t &total = merged[t];
+			int seed;
+
+			total.max_resp_time.assign(num_tasks, 0);
+			total.num_jobs.assign(num_tasks, 0);
+			total.deadline_misses.assign(num_tasks, 0);
+			total.resp_histogram.assign(num_tasks, std::vector<long>());
+			total.total_jobs = 0;
+
+			seed_params.record_histogram = true;
+			while ((seed = next_seed++) < num_seeds)
+			{
+				seed_params.seed = params.seed + seed;
+				if (simulate_taskset(task_vector, seed_params, stats) != 0)
+				{
+					sim_error = 1;
+					return;
+				}
+
+				total.total_jobs += stats.total_jobs;
+				for (unsigned int index = 0; index < num_tasks; index++)
+				{
+					total.max_resp_time[index] = std::max(total.max_resp_time[index], stats.max_resp_time[index]);
+					total.num_jobs[index] += stats.num_jobs[index];
+					total.deadline_misses[index] += stats.deadline_misses[index];
+					if (stats.resp_histogram[index].size() > total.resp_histogram[index].size())
+						total.resp_histogram[index].resize(stats.resp_histogram[index].size(), 0);
+					for (unsigned int bucket = 0; bucket < stats.resp_histogram[index].size(); bucket++)
+						total.resp_histogram[index][bucket] += stats.resp_histogram[index][bucket];
+				}
+			}
+		});
+	}
+	for (unsigned int t = 0; t < threads.size(); t++)
+		threads[t].join();
+	if (sim_error)
+		return -1;
+
+	// Merge the threads into the first one
+	for (int t = 1; t < num_threads; t++)
+	{
+		merged[0].total_jobs += merged[t].total_jobs;
+		for (unsigned int index = 0; index < num_tasks; index++)
+		{
+			merged[0].max_resp_time[index] = std::max(merged[0].max_resp_time[index], merged[t].max_resp_time[index]);
+			merged[0].num_jobs[index] += merged[t].num_jobs[index];
+			merged[0].deadline_misses[index] += merged[t].deadline_misses[index];
+			if (merged[t].resp_histogram[index].size() > merged[0].resp_histogram[index].size())
+				merged[0].resp_histogram[index].resize(merged[t].resp_histogram[index].size(), 0);
+			for (unsigned int bucket = 0; bucket < merged[t].resp_histogram[index].size(); bucket++)
+				merged[0].resp_histogram[index][bucket] += merged[t].resp_histogram[index][bucket];
+		}
+	}
+
+	// The percentiles never exceed the observed maximum
+	distribution.p50.resize(num_tasks);
+	distribution.p99.resize(num_tasks);
+	distribution.p999.resize(num_tasks);
+	for (unsigned int index = 0; index < num_tasks; index++)
+	{
+		distribution.p50[index] = std::min(sim_histogram_percentile(merged[0].resp_histogram[index], 0.5), merged[0].max_resp_time[index]);
+		distribution.p99[index] = std::min(sim_histogram_percentile(merged[0].resp_histogram[index], 0.99), merged[0].max_resp_time[index]);
+		distribution.p999[index] = std::min(sim_histogram_percentile(merged[0].resp_histogram[index], 0.999), merged[0].max_resp_time[index]);
+	}
+	distribution.max_resp_time = merged[0].max_resp_time;
+	distribution.num_jobs = merged[0].num_jobs;
+	distribution.deadline_misses = merged[0].deadline_misses;
+	distribution.total_jobs = merged[0].total_jobs;
+	return 0;
+}
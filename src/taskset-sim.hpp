@@ -0,0 +1,230 @@
+/*
+ * @file taskset-sim.hpp
+ * @brief Discrete-event simulator of the multicore system with a concurrent GPU
+ * @author Anon 
+ * 
+ * Copyright (c) Anon, 2019. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 	1. Redistributions of source code must retain the above copyright notice, 
+ *     this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright notice, 
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef TASKSET_SIM_HPP
+#define TASKSET_SIM_HPP
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "task.hpp"
+#include "task_partitioning.hpp"
+#include "sim-trace.hpp"
+#include "config.hpp"
+
+/* Queueing of the GPU requests */
+enum sim_gpu_policy
+{
+	SIM_GPU_PRIORITY 	= 0,	// the highest-priority waiting request that fits is granted first (smaller requests may pass bigger ones)
+	SIM_GPU_FIFO 		= 1		// requests are granted in arrival order, a request that does not fit holds back the later ones
+};
+
+/* Execution times of the jobs */
+enum sim_exec_model
+{
+	SIM_EXEC_WCET 		= 0,	// every phase executes for its WCET
+	SIM_EXEC_UNIFORM 	= 1		// every phase executes for a uniform draw in [bcet_ratio, 1] times its WCET (C, Gm, Ge)
+};
+
+typedef struct sim_params {
+	int gpu_policy;				// sim_gpu_policy
+	bool concurrent;			// requests share the GPU by their fraction, otherwise each request holds the whole GPU
+	double horizon;				// releases happen before it, the hyperperiod (at most SIM_MAX_HORIZON) if 0
+	int exec_model;				// sim_exec_model
+	double bcet_ratio;			// shortest execution relative to the WCET (SIM_EXEC_UNIFORM)
+	unsigned int seed;			// seed of the execution time draws
+	bool record_histogram;		// fill the response-time histograms of the stats
+} sim_params_t;
+
+typedef struct sim_stats {
+	std::vector<double> max_resp_time;		// observed worst-case response time of each task (from the release of the part)
+	std::vector<long> num_jobs;				// completed jobs of each task
+	std::vector<long> deadline_misses;		// jobs of each task completed after their deadline
+	std::vector<std::vector<long>> resp_histogram;	// response times of each task per histogram bucket (if recorded)
+	long total_jobs;
+	long num_events;
+	double horizon;							// horizon used
+} sim_stats_t;
+
+/* Response-time distribution of each task over several simulations */
+typedef struct sim_distribution {
+	std::vector<double> p50;
+	std::vector<double> p99;
+	std::vector<double> p999;
+	std::vector<double> max_resp_time;
+	std::vector<long> num_jobs;
+	std::vector<long> deadline_misses;
+	long total_jobs;
+} sim_distribution_t;
+
+/* Event of the simulation */
+typedef struct sim_event {
+	double time;
+	int kind;
+	unsigned int id;			// core of a CPU completion, task otherwise
+	uint64_t stamp;				// dispatch stamp of the core for a CPU completion, stale completions are skipped
+	uint64_t seq;				// insertion order, breaks the remaining ties
+} sim_event_t;
+
+/* State of a task and of its current job */
+typedef struct sim_task_state {
+	unsigned int core;
+	unsigned int num_phases;	// a CPU chunk, then launch, GPU execution and completion per segment, then the last CPU chunk
+	double cpu_chunk;			// C split evenly around the GPU segments
+	int tail;					// task released by the completion of this split head, -1 otherwise
+	bool active;
+	double release;
+	unsigned int phase;
+	double remaining;			// execution left in the phase
+	bool granted;				// holds its share of the GPU
+	double gm_exec;				// Gm drawn for the current segment, half before and half after the GPU execution
+	double gpu_start;			// start of the GPU execution and its trace lane
+	unsigned int gpu_lane;
+	uint64_t flow_to_gpu;		// trace flows from the launch to the GPU execution and from it to the completion
+	uint64_t flow_from_gpu;
+	std::deque<double> backlog;	// releases that found a job still active
+} sim_task_state_t;
+
+/* State of a core */
+typedef struct sim_core_state {
+	int running;				// task executing, -1 if idle
+	double last_update;
+	double slice_start;			// start of the running task's trace slice
+	uint64_t stamp;
+} sim_core_state_t;
+
+/* Fixed-priority preemptive cores (task_vector order, index 0 highest), each task on its core id; a GPU segment acquires its
+   fraction of the GPU, runs half of Gm on its core above every normal execution, suspends for Ge on the GPU, runs the other
+   half of Gm and releases the GPU; waiting for the GPU suspends the job. Tasks are released periodically from 0, with their
+   WCETs or random execution times, and the tail of a split task when its head completes */
+class TasksetSimulator
+{
+	// Constructor and destructor
+	public: TasksetSimulator(const std::vector<Task> &task_vector, const sim_params_t &params);
+	public: ~TasksetSimulator();
+
+	// Simulate up to the horizon and until the released jobs complete, 0 on success, -1 if a task has no period
+	public: int run(sim_stats_t &stats);
+
+	// Write the schedule to an open trace (NULL -> no trace)
+	public: void setTrace(SimTraceWriter *trace_writer);
+
+	// Job progress
+	private: void startJob(unsigned int task, double release, double now);
+	private: void enterPhase(unsigned int task, double now);
+	private: void finishPhase(unsigned int task, double now);
+	private: void completeJob(unsigned int task, double now);
+
+	// GPU sharing
+	private: bool requestGPU(unsigned int task, double now);
+	private: void releaseGPU(unsigned int task, double now);
+	private: double getFraction(unsigned int task, unsigned int segment) const;
+
+	// Execution time of a phase under the execution model
+	private: double drawExec(double wcet);
+
+	// Cores and ready sets (one bit per task, boosted GPU interventions run before the normal executions)
+	private: void setReady(unsigned int task, bool boosted);
+	private: void clearReady(unsigned int task);
+	private: int pickTask(unsigned int core) const;
+	private: void dispatch(unsigned int core, double now);
+
+	// Trace the execution of the running task of a core up to now, completes if its phase ends there
+	private: void traceSlice(unsigned int core, double now, bool completes);
+
+	// Event queue (binary heap)
+	private: void pushEvent(double time, int kind, unsigned int id, uint64_t stamp);
+	private: sim_event_t popEvent();
+
+	// Private Variables
+	private: const std::vector<Task> &tasks;
+	private: sim_params_t params;
+	private: unsigned int num_cores;
+	private: unsigned int mask_words;
+	private: std::vector<sim_task_state_t> task_state;
+	private: std::vector<sim_core_state_t> core_state;
+	private: std::vector<uint64_t> normal_ready;		// mask_words per core
+	private: std::vector<uint64_t> boosted_ready;
+	private: std::vector<unsigned int> dirty_cores;
+	private: std::vector<bool> core_dirty;
+	private: std::vector<unsigned int> gpu_waiting;	// in arrival order
+	private: double gpu_used;
+	private: std::vector<sim_event_t> events;
+	private: uint64_t event_seq;
+	private: std::mt19937 exec_engine;
+	private: sim_stats_t *stats;
+	private: SimTraceWriter *trace;
+};
+
+/**************** Simulation parameters matching a schedulability test ********************/ 
+/* Params: sched_mode: the test, its GPU model is simulated (exclusive for the non-concurrent tests, FIFO for FIFO-Conc)
+		   params    : populated by the function, with the default horizon
+   Returns: 0 on success, -1 for an invalid test */
+int get_sim_params(sched_type sched_mode, sim_params_t &params);
+
+/**************** Response-time histogram ********************/ 
+/* Buckets of relative width SIM_HISTOGRAM_RESOLUTION above SIM_HISTOGRAM_FLOOR (shorter response times share bucket 0),
+   a percentile is read as the upper edge of its bucket so it is overestimated by at most the resolution
+   Params: resp_time: response time
+		   bucket   : bucket index
+		   histogram: counts per bucket
+		   percentile: in [0, 1]
+   Returns: the bucket of a response time, the upper edge of a bucket, the percentile of a histogram (0 if empty) */
+unsigned int sim_histogram_bucket(double resp_time);
+double sim_histogram_upper_edge(unsigned int bucket);
+double sim_histogram_percentile(const std::vector<long> &histogram, double percentile);
+
+/**************** Simulate a partitioned taskset ********************/ 
+/* Params: task_vector: tasks in priority order with their core ids
+		   params     : GPU model and horizon
+		   stats      : observed response times (populated by the function)
+   Returns: 0 on success, -1 if a task has no period */
+int simulate_taskset(const std::vector<Task> &task_vector, const sim_params_t &params, sim_stats_t &stats);
+
+/**************** Simulate a partitioned taskset and trace its schedule ********************/ 
+/* Params: see simulate_taskset
+		   trace_filename: Chrome trace-event JSON written while simulating (chrome://tracing, Perfetto)
+   Returns: 0 on success, -1 if a task has no period or the trace cannot be written */
+int simulate_taskset_trace(const std::vector<Task> &task_vector, const sim_params_t &params, sim_stats_t &stats, 
+						   const std::string &trace_filename);
+
+/**************** Simulate a partitioned taskset with random execution times ********************/ 
+/* Seeds params.seed to params.seed + num_seeds - 1 are simulated by num_threads threads and their histograms merged
+   Params: task_vector: tasks in priority order with their core ids
+		   params     : GPU model, horizon, execution model and first seed
+		   num_seeds  : number of simulations
+		   num_threads: threads running them, 0 for one per hardware thread
+		   distribution: percentiles of the response times of each task (populated by the function)
+   Returns: 0 on success, -1 if a task has no period */
+int simulate_taskset_monte_carlo(const std::vector<Task> &task_vector, const sim_params_t &params, int num_seeds, int num_threads,
+								 sim_distribution_t &distribution);
+
+#endif
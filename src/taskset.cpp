@@ -27,6 +27,8 @@
 
 #include <iostream> 
 #include <cmath>
+#include <vector>
+#include <algorithm>
 
 #include "taskset.hpp"
 
@@ -136,6 +138,22 @@ double get_taskset_gpu_util(const std::vector<Task> &task_vector)
 	return gpu_util;
 }
 
+/**************** Get the number of cores hosting GPU-using tasks *************************/
+/* Params: task_vector: vector of tasks (mapped to cores)
+   Returns: number of distinct cores with at least one GPU-using task */
+unsigned int get_num_gpu_cores(const std::vector<Task> &task_vector)
+{
+	std::vector<unsigned int> gpu_cores;
+	for (unsigned int index = 0; index < task_vector.size(); index++) 
+	{
+		if (task_vector[index].getNumGPUSegments() == 0)
+			continue;
+		if (std::find(gpu_cores.begin(), gpu_cores.end(), task_vector[index].getCoreID()) == gpu_cores.end())
+			gpu_cores.push_back(task_vector[index].getCoreID());
+	}
+	return gpu_cores.size();
+}
+
 /* Find index of max lp task with largest GPU segment */
 /* Params: index      : task index in vector ordered by priority
            task_vector: vector of tasks 
@@ -29,9 +29,13 @@
 #define TASKSET_HPP
 
 #include <vector>
+#include <limits>
 
 #include "task.hpp"
 
+/* Starting value of the find_next_* searches, above any segment length */
+#define SEGMENT_SEARCH_UNBOUNDED (std::numeric_limits<double>::infinity())
+
 /**************** Print all the tasks in the taskset *************************/
 /* Params: task_vector: vector of tasks 
    Returns: 0 if schedulable */
@@ -59,6 +63,11 @@ double get_gputasks_cpu_util(const std::vector<Task> &task_vector);
    Returns: gpu utilization */
 double get_taskset_gpu_util(const std::vector<Task> &task_vector);
 
+/**************** Get the number of cores hosting GPU-using tasks *************************/
+/* Params: task_vector: vector of tasks (mapped to cores)
+   Returns: number of distinct cores with at least one GPU-using task */
+unsigned int get_num_gpu_cores(const std::vector<Task> &task_vector);
+
 /* Find index of max lp task with largest GPU segment */
 /* Params: index      : task index in vector ordered by priority
            task_vector: vector of tasks 
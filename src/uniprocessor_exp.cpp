@@ -39,6 +39,8 @@
 #include "task.hpp"
 #include "taskset.hpp"
 #include "taskset-gen.hpp"
+#include "taskset-corpus.hpp"
+#include "sched-config.hpp"
 #include "config.hpp"
 
 /* Schedulability test headers */
@@ -62,12 +64,47 @@ struct CompareTaskPriorityRMS {
 int main(int argc, char **argv)
 {
 	std::vector<Task> task_vector;
+	taskset_arena_t arena;
 	double true_gpu_util, true_cpu_util;
 	int number_tasks;
 	int retval;
 	int number_gpu_tasks;
 	int taskset_counter = 0;
 
+	// Common random numbers (--crn-seed <seed>): taskset i of every sweep point gets the same random draws, the hyperperiod
+	// cap of divisor-rich periods (--hyperperiod-cap <cap>) and the runtime configuration (--config <key>=<value>,
+	// --config-file <file>), the positional arguments follow without them
+	unsigned int crn_seed = 0;
+	int crn_index = -1;
+	std::vector<char *> positional_args;
+	for (int index = 0; index < argc; index++)
+	{
+		if (std::string(argv[index]) == "--crn-seed" && index + 1 < argc)
+			crn_seed = std::strtoul(argv[++index], NULL, 10);
+		else if (std::string(argv[index]) == "--hyperperiod-cap" && index + 1 < argc)
+		{
+			if (set_hyperperiod_cap(std::strtoull(argv[++index], NULL, 10)) == 0)
+			{
+				std::cout << "No period fits under the hyperperiod cap, Exiting ..\n";
+				exit(1);
+			}
+		}
+		else if (std::string(argv[index]) == "--config" && index + 1 < argc)
+		{
+			if (apply_sched_config(argv[++index]) != 0)
+				exit(1);
+		}
+		else if (std::string(argv[index]) == "--config-file" && index + 1 < argc)
+		{
+			if (apply_sched_config_file(argv[++index]) != 0)
+				exit(1);
+		}
+		else
+			positional_args.push_back(argv[index]);
+	}
+	argc = positional_args.size();
+	argv = positional_args.data();
+
 	// Schedulability Flags
 	int sched_flag_rd = 0;
 	int sched_flag_jd = 0;
@@ -102,7 +139,7 @@ int main(int argc, char **argv)
 	if (argc > 1)
 		taskset_count = std::atoi(argv[1]);
 
-	// Generate only harmonic tasksets
+	// Generate only harmonic tasksets (2: divisor-rich periods with a bounded hyperperiod)
 	int harmonic_flag = 0;
 	if (argc > 2)
 		harmonic_flag = std::atoi(argv[2]);
@@ -176,56 +213,106 @@ int main(int argc, char **argv)
 	std::vector<double> resp_time_jd;
 	std::vector<double> job_blocking_jd;
 
+	// Hybrid and FIFO Vectors
+	std::vector<double> resp_time;
+
+	// Taskset corpus (1 = record the generated tasksets, 2 = analyse the tasksets of the corpus)
+	std::string corpus_filename;
+	int corpus_mode = CORPUS_NONE;
+	if (argc > 13)
+	{
+		corpus_filename = argv[12];
+		corpus_mode = std::atoi(argv[13]);
+	}
+	if (corpus_mode < CORPUS_NONE || corpus_mode > CORPUS_READ)
+	{
+		std::cout << "Invalid corpus mode chosen, Exiting ..\n";
+		exit(1);
+	}
+
+	CorpusReader corpus_reader;
+	CorpusWriter corpus_writer;
+	if (corpus_mode == CORPUS_READ)
+	{
+		if (corpus_reader.open(corpus_filename) != 0)
+			exit(1);
+		if ((unsigned long) taskset_count > corpus_reader.getNumTasksets())
+			taskset_count = corpus_reader.getNumTasksets();
+		std::cout << "Corpus Tasksets: " << corpus_reader.getNumTasksets() << "\n";
+	}
+	else if (corpus_mode == CORPUS_WRITE)
+		corpus_writer.open(corpus_filename);
+
 	/* initialize random seed: */
   	srand (time(NULL));
 
 	while (taskset_counter < taskset_count)
 	{
-		// Chose parameters based on mode
-		/* 0 = CPU Util/GPU Util, 1 = Fraction of tasks with GPU segments, 2 = Number of gpu segments, 3 = max size (fraction) of GPU segment*/
-		switch (mode)
+		// Analyse the tasksets of the corpus instead of generating them (they were recorded in priority order)
+		if (corpus_mode == CORPUS_READ)
 		{
-			case 0:
-				number_tasks = (rand() % max_number_tasks) + 1;
-				number_gpu_tasks = ceil(gpu_task_fraction*number_tasks); // Guarantees minimum fraction of tasks as specified
-				num_gpu_seg_random_flag = 1;
-				break;
+			if (corpus_reader.materialize(taskset_counter, task_vector) != 0)
+			{
+				std::cout << "Corrupt taskset " << taskset_counter << " in corpus, Exiting ..\n";
+				exit(1);
+			}
+		}
+		else
+		{
+			// Retries of a failed generation continue the taskset's stream
+			if (crn_seed != 0 && crn_index != taskset_counter)
+			{
+				seed_taskset_stream(crn_seed, taskset_counter);
+				crn_index = taskset_counter;
+			}
+
+			// Chose parameters based on mode
+			/* 0 = CPU Util/GPU Util, 1 = Fraction of tasks with GPU segments, 2 = Number of gpu segments, 3 = max size (fraction) of GPU segment*/
+			switch (mode)
+			{
+				case 0:
+					number_tasks = (taskset_rand() % max_number_tasks) + 1;
+					number_gpu_tasks = ceil(gpu_task_fraction*number_tasks); // Guarantees minimum fraction of tasks as specified
+					num_gpu_seg_random_flag = 1;
+					break;
 			
-			case 1:
-				number_tasks = max_number_tasks;
-				number_gpu_tasks = floor(gpu_task_fraction*number_tasks);
-				num_gpu_seg_random_flag = 1;
-				break;
+				case 1:
+					number_tasks = max_number_tasks;
+					number_gpu_tasks = floor(gpu_task_fraction*number_tasks);
+					num_gpu_seg_random_flag = 1;
+					break;
 			
-			case 2:
-				number_tasks = max_number_tasks;
-				number_gpu_tasks = floor(gpu_task_fraction*number_tasks);
-				num_gpu_seg_random_flag = 0;
-				break;
-
-			case 3:
-				number_tasks = (rand() % max_number_tasks) + 1;
-				number_gpu_tasks = ceil(gpu_task_fraction*number_tasks); // Guarantees minimum fraction of tasks as specified
-				num_gpu_seg_random_flag = 1;
-				break;
+				case 2:
+					number_tasks = max_number_tasks;
+					number_gpu_tasks = floor(gpu_task_fraction*number_tasks);
+					num_gpu_seg_random_flag = 0;
+					break;
+
+				case 3:
+					number_tasks = (taskset_rand() % max_number_tasks) + 1;
+					number_gpu_tasks = ceil(gpu_task_fraction*number_tasks); // Guarantees minimum fraction of tasks as specified
+					num_gpu_seg_random_flag = 1;
+					break;
 			
-			default:
-				std::cout << "Invalid mode chosen, Exiting ..\n";
-				exit(1);
+				default:
+					std::cout << "Invalid mode chosen, Exiting ..\n";
+					exit(1);
+			}
+
+			if (DEBUG)
+				std::cout << "Taskset " << taskset_counter << " NumTasks = " << number_tasks << " NumAccTasks = " << number_gpu_tasks<< std::endl;
+			// If the generation failed try again
+			if (generate_tasks_in_place(arena, task_vector, number_tasks, number_gpu_tasks, number_gpu_segments, utilization_bound, 
+										gpu_utilization_bound, harmonic_flag, num_gpu_seg_random_flag, max_gpu_fraction) != 0)
+				continue;
+
+			// Sort Vector based on Some Priority ordering (here RMS)
+			std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
+
+			if (corpus_mode == CORPUS_WRITE)
+				corpus_writer.addTaskset(task_vector);
 		}
 
-		if (DEBUG)
-			std::cout << "Taskset " << taskset_counter << " NumTasks = " << number_tasks << " NumAccTasks = " << number_gpu_tasks<< std::endl;
-		task_vector = generate_tasks(number_tasks, number_gpu_tasks, number_gpu_segments, utilization_bound, gpu_utilization_bound, 
-									 harmonic_flag, num_gpu_seg_random_flag, max_gpu_fraction);
-
-		// If Task Vector is empty the try again
-		if (task_vector.empty())
-			continue;
-
-		// Sort Vector based on Some Priority ordering (here RMS)
-		std::sort(task_vector.begin(), task_vector.end(), ComparePriorityRMS);
-
 		if (DEBUG)
 			print_taskset(task_vector);
 
@@ -235,7 +322,7 @@ int main(int argc, char **argv)
 		resp_time_jd.clear();
 		sched_flag_rd = check_schedulability_request_driven(task_vector, resp_time_rd, req_blocking_rd);
 		sched_flag_jd = check_schedulability_job_driven(task_vector, resp_time_jd);
-		sched_flag_hybrid = check_schedulability_hybrid(task_vector, resp_time_rd, resp_time_jd, req_blocking_rd);
+		sched_flag_hybrid = check_schedulability_hybrid(task_vector, resp_time_rd, resp_time_jd, req_blocking_rd, resp_time);
 		
 		// Check Schedulability -> Concurrent approaches (simple)
 		resp_time_rd.clear();
@@ -252,8 +339,8 @@ int main(int argc, char **argv)
 		job_blocking_jd.clear();
 		sched_flag_rd_conc = check_schedulability_request_driven_conc(task_vector, resp_time_rd, req_blocking_rd, false);
 		sched_flag_jd_conc_ro = check_schedulability_job_driven_conc(task_vector, resp_time_jd, job_blocking_jd, true);
-		sched_flag_hybrid_conc = check_schedulability_hybrid_conc(task_vector, resp_time_rd, resp_time_jd, req_blocking_rd, job_blocking_jd);
-		sched_flag_fifo_conc = check_schedulability_fifo_conc(task_vector);
+		sched_flag_hybrid_conc = check_schedulability_hybrid_conc(task_vector, resp_time_rd, resp_time_jd, req_blocking_rd, job_blocking_jd, resp_time);
+		sched_flag_fifo_conc = check_schedulability_fifo_conc(task_vector, resp_time);
 
 		if (DEBUG)
 		{
@@ -308,6 +395,14 @@ int main(int argc, char **argv)
 		taskset_counter++;
 	}
 
+	// Record the corpus once every taskset is in it
+	if (corpus_mode == CORPUS_WRITE)
+	{
+		if (corpus_writer.close() != 0)
+			exit(1);
+		std::cout << "Corpus Tasksets: " << corpus_writer.getNumTasksets() << "\n";
+	}
+
 	// Compute the Average
 	average_gpu_util = average_gpu_util/taskset_count;
 	average_cpu_util = average_cpu_util/taskset_count;
@@ -330,6 +425,14 @@ int main(int argc, char **argv)
 		outfile.close();
 	}
 
+	// Report the utilization sampler counters (only UUniFast-Discard discards draws)
+	long util_draws, util_discards, util_failures;
+	get_util_sampler_stats(util_draws, util_discards, util_failures);
+	std::cout << "Util. Draws/Discards/Failures: " << util_draws << "/" << util_discards << "/" << util_failures;
+	if (util_draws > 0)
+		std::cout << " (discard rate " << double(util_discards)/util_draws << ")";
+	std::cout << "\n";
+
 	std::cout << "Tasksets: " << taskset_count << "\n";
 	std::cout << "Avg. CPU Util :" << average_cpu_util << "\n";
 	std::cout << "Avg. GPU Util :" << average_gpu_util << "\n";